@@ -40,6 +40,8 @@ typedef struct S_MBRNode {
 	short Drive;
 	short Type; // primary or logical
 	TPartTable *Table;
+	TPartEntry Shadow[4]; // entries as they are on disk
+	int Dirty;
 	struct S_MBRNode *Next;
 } TMBRNode;
 
@@ -55,6 +57,7 @@ typedef struct {
 typedef struct S_PartNode {
 	TPartEntry *Entry;
 	TPartition *Partition;
+	TMBRNode *MBRNode; // table holding Entry, NULL for non-partitions
 	struct S_PartNode *Next;
 } TPartNode;
 
@@ -81,6 +84,8 @@ class CPartList {
 		} TFSNameEntry;
 	private:
 		void ClearActive(int Drive);
+		void MarkDirty(int Index);
+		void WriteDrive(TMBRNode **Nodes, int Count);
 
 		TMBRNode *AddDrive(int Drive, unsigned long StartSector, unsigned long ExtStart, int Type, TMBRNode *MBRList);
 		void CreatePartList(int FloppyCount);
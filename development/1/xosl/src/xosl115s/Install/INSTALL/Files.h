@@ -21,6 +21,7 @@ public:
 	const char *GetFileName(int Index);
 	const char *GetXoslDataName();
 	const char *GetBootItemName();
+	const char *GetPartSnapshotName();
 
 	const char *GetCurrentMbrName();
 	const char *GetOriginalMbrName();
@@ -42,6 +43,7 @@ private:
 
 	static const char *XoslData;
 	static const char *BootItem;
+	static const char *PartSnapshot;
 	static const char *CurrentMBR;
 	static const char *OriginalMBR;
 
@@ -47,6 +47,8 @@ int CInstaller::Install(CVesa::TGraphicsMode GraphicsMode, CMouse::TMouseType Mo
 		return -1;
 	if (CreateBootItem() == -1)
 		return -1;
+	if (CreatePartSnapshot() == -1)
+		return -1;
 	if (BackupOriginalMbr(0,XoslFiles.GetOriginalMbrName()) == -1)
 		return -1; 
 
@@ -95,6 +97,8 @@ int CInstaller::Install(CVesa::TGraphicsMode GraphicsMode, CMouse::TMouseType Mo
 		return -1;
 	if (CreateBootItem() == -1)
 		return -1;
+	if (CreatePartSnapshot() == -1)
+		return -1;
 	if (BackupOriginalMbr(Partition->FSType,XoslFiles.GetOriginalMbrName()) == -1)
 		return -1;
 	
@@ -285,6 +289,34 @@ int CInstaller::CreateBootItem()
 	return 0;
 }
 
+int CInstaller::CreatePartSnapshot()
+/*
+ * Zero filled, so XOSL does a full partition scan on first boot
+ */
+{
+	char *SnapshotData = new char[PARTSNAP_FILESIZE];
+	int hFile;
+
+	TextUI.OutputStr("Creating partition snapshot file...");
+	MemSet(SnapshotData,0,PARTSNAP_FILESIZE);
+	if ((hFile = DosFile.Create(XoslFiles.GetPartSnapshotName())) == -1) {
+		TextUI.OutputStr("failed\nUnable to create %s\n",XoslFiles.GetPartSnapshotName());
+		delete[] SnapshotData;
+		return -1;
+	}
+	if (DosFile.Write(hFile,SnapshotData,PARTSNAP_FILESIZE) != PARTSNAP_FILESIZE) {
+		TextUI.OutputStr("failed\nDisk full.\n");
+		DosFile.Close(hFile);
+		delete[] SnapshotData;
+		return -1;
+	}
+
+	DosFile.Close(hFile);
+	TextUI.OutputStr("done\n");
+	delete[] SnapshotData;
+	return 0;
+}
+
 int CInstaller::BackupOriginalMbr(int PartId, const char *DestFileName)
 {
 	CDisk Disk;
@@ -28,6 +28,7 @@
 
 #define BOOTITEM_FILESIZE 4096
 #define LASTCONF_FILESIZE 512
+#define PARTSNAP_FILESIZE 8192
 
 
 class CInstaller {
@@ -54,6 +55,7 @@ private:
 
 	int CreateXoslData(CVesa::TGraphicsMode GraphicsMode, CMouse::TMouseType MouseType);
 	int CreateBootItem();
+	int CreatePartSnapshot();
 
 	int BackupOriginalMbr(int PartId, const char *DestFileName);
 	int BackupCurrentMbr(void *Ipl);
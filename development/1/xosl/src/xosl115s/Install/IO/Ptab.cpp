@@ -11,6 +11,7 @@
 #include <ptab.h>
 #include <transfer.h>
 #include <disk.h>
+#include <memory.h>
 
 #define FSTYPE_EXTENDED 0x05
 #define FSTYPE_EXTENDEDLBA 0x0f
@@ -63,6 +64,8 @@ TMBRNode *CPartList::AddDrive(int Drive, unsigned long StartSector, unsigned lon
 	MBRList->Drive = Drive;
 	MBRList->Type = Type;
 	MBRList->Table = PartTable;
+	MemCopy(MBRList->Shadow,PartTable->Entries,sizeof (TPartEntry[4]));
+	MBRList->Dirty = 0;
 	Entries = MBRList->Table->Entries;
 	for (Index = 0; Index < 4; ++Index)
 		switch (Entries[Index].FSType) {
@@ -128,6 +131,7 @@ TPartNode *CPartList::CreateNonPartNode(int Drive)
 	PartNode = new TPartNode;
 	Partition = PartNode->Partition = new TPartition;
 	PartNode->Entry = NULL;
+	PartNode->MBRNode = NULL;
 
 	Partition->Drive = Drive;
 	Partition->StartSector = 0;
@@ -154,6 +158,7 @@ TPartNode *CPartList::CreatePartNode(const TMBRNode *MBRNode, int Index)
 	PartNode = new TPartNode;
 	Partition = PartNode->Partition = new TPartition;
 	PartEntry = PartNode->Entry = &MBRNode->Table->Entries[Index];
+	PartNode->MBRNode = (TMBRNode *)MBRNode;
 
 	Partition->Drive = MBRNode->Drive;
 	Partition->StartSector = MBRNode->AbsoluteSector + PartEntry->RelativeSector;
@@ -183,15 +188,62 @@ void CPartList::CreatePLUP()
 		PLUP[Index] = PartList;
 }
 
+void CPartList::MarkDirty(int Index)
+{
+	if (PLUP[Index]->MBRNode)
+		PLUP[Index]->MBRNode->Dirty = 1;
+}
+
 void CPartList::WriteStructure()
+/*
+ * Only tables that are marked dirty _and_ differ from what was read
+ * from disk are written, per drive in ascending sector order.
+ */
 {
-	CDisk Disk;
 	TMBRNode *MBRList;
-
+	TMBRNode **Nodes;
+	int NodeCount, Index, Insert, First;
+
+	for (NodeCount = 0, MBRList = this->MBRList.Next; MBRList; MBRList = MBRList->Next, ++NodeCount);
+	if (!NodeCount)
+		return;
+	Nodes = new TMBRNode *[NodeCount];
+	NodeCount = 0;
 	for (MBRList = this->MBRList.Next; MBRList; MBRList = MBRList->Next) {
-		Disk.Map(MBRList->Drive,MBRList->AbsoluteSector);
-		Disk.Write(0,MBRList->Table,1);
+		if (!MBRList->Dirty)
+			continue;
+		if (MemCompare(MBRList->Shadow,MBRList->Table->Entries,sizeof (TPartEntry[4])) == 0) {
+			MBRList->Dirty = 0;
+			continue;
+		}
+		// insertion sort on (Drive, AbsoluteSector)
+		for (Insert = NodeCount; Insert && (Nodes[Insert - 1]->Drive > MBRList->Drive ||
+			(Nodes[Insert - 1]->Drive == MBRList->Drive &&
+			Nodes[Insert - 1]->AbsoluteSector > MBRList->AbsoluteSector)); --Insert)
+			Nodes[Insert] = Nodes[Insert - 1];
+		Nodes[Insert] = MBRList;
+		++NodeCount;
+	}
+
+	for (First = 0; First < NodeCount; First = Index) {
+		for (Index = First + 1; Index < NodeCount && Nodes[Index]->Drive == Nodes[First]->Drive; ++Index);
+		WriteDrive(&Nodes[First],Index - First);
 	}
+	delete[] Nodes;
+}
+
+void CPartList::WriteDrive(TMBRNode **Nodes, int Count)
+{
+	CDisk Disk;
+	int Index;
+
+	if (Disk.Map(Nodes[0]->Drive,0) == -1)
+		return;
+	for (Index = 0; Index < Count; ++Index)
+		if (Disk.Write(Nodes[Index]->AbsoluteSector,Nodes[Index]->Table,1) != -1) {
+			MemCopy(Nodes[Index]->Shadow,Nodes[Index]->Table->Entries,sizeof (TPartEntry[4]));
+			Nodes[Index]->Dirty = 0;
+		}
 }
 
 const TPartition *CPartList::GetPartition(int Index)
@@ -236,14 +288,18 @@ int CPartList::CanHide(int Index)
 
 void CPartList::Hide(int Index)
 {
-	if (CanHide(Index))
+	if (CanHide(Index)) {
 		PLUP[Index]->Entry->FSType |= 0x10;
+		MarkDirty(Index);
+	}
 }
 
 void CPartList::Reveal(int Index)
 {
-	if (CanHide(Index))
+	if (CanHide(Index)) {
 		PLUP[Index]->Entry->FSType &= 0xef;
+		MarkDirty(Index);
+	}
 }
 
 int CPartList::CanActivate(int Index)
@@ -263,26 +319,27 @@ void CPartList::ClearActive(int Drive)
 {
 	int Index;
 
-	if (!AllowActiveHD)
-		// clear active flag for all partitions
-		for (Index = 0; Index < Count; ++Index)
+	for (Index = 0; Index < Count; ++Index)
+		// clear active flag for all partitions, or only for
+		// partitions on the same drive
+		if ((!AllowActiveHD || PLUP[Index]->Partition->Drive == Drive) &&
+			PLUP[Index]->Entry->Activated) {
 			PLUP[Index]->Entry->Activated = 0x00;
-	else
-		// clear active flag only for all partitions on same drive
-		for (Index = 0; Index < Count; ++Index)
-			if (PLUP[Index]->Partition->Drive == Drive)
-				PLUP[Index]->Entry->Activated = 0x00;
+			MarkDirty(Index);
+		}
 }
 
 void CPartList::SetActive(int Index)
 {
 	ClearActive(PLUP[Index]->Partition->Drive);
 	PLUP[Index]->Entry->Activated = 0x80;
+	MarkDirty(Index);
 }
 
 void CPartList::SetFsType(int Index, int FsType)
 {
 	PLUP[Index]->Entry->FSType = FsType;
+	MarkDirty(Index);
 }
 
 
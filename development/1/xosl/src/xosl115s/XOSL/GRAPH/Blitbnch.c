@@ -0,0 +1,288 @@
+/*
+ * Extended Operating System Loader (XOSL)
+ * Copyright (c) 1999 by Geurt Vos
+ *
+ * This code is distributed under GNU General Public License (GPL)
+ *
+ * The full text of the license can be found in the GPL.TXT file,
+ * or at http://www.gnu.org
+ */
+
+/*
+ * Host side micro-benchmark of the row loops in PMGRAPH.ASM. It is not
+ * part of graph.lib. Build and run it with any 32 or 64 bit C compiler:
+ *
+ *   cc -O2 -fno-tree-vectorize -o blitbnch blitbnch.c
+ *   ./blitbnch [width height]
+ *
+ * -fno-tree-vectorize keeps the compiler from turning the loops into
+ * something neither version does. The surfaces are plain memory, with
+ * the width of the screen buffer (default 800x600, 8 bpp).
+ *
+ * The old loops copy or fill each row as dwords from wherever the row
+ * starts, followed by the odd bytes (Buffer2Buffer used words). The new
+ * CopyRow and FillRow first align the destination to a dword, and an
+ * area of full screen width is done as one block. Every case is checked
+ * against the old result before it is timed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef unsigned int DWORD; // 32 bits on every host this runs on
+
+static unsigned char *Screen, *Buffer, *Reference;
+static long GRWidth, GRHeight;
+
+typedef struct {
+	const char *Name;
+	long Left, Top, Width, Height;
+} TArea;
+
+static void CopyDwords(unsigned char *Dest, const unsigned char *Src, long Count)
+/*
+ * rep movsd: the source may be unaligned on the host as well
+ */
+{
+	DWORD Value;
+
+	for (; Count; --Count, Dest += 4, Src += 4) {
+		memcpy(&Value,Src,4);
+		memcpy(Dest,&Value,4);
+	}
+}
+
+static void CopyBytes(unsigned char *Dest, const unsigned char *Src, long Count)
+{
+	for (; Count; --Count)
+		*Dest++ = *Src++;
+}
+
+static void FillDwords(unsigned char *Dest, DWORD Color, long Count)
+{
+	for (; Count; --Count, Dest += 4)
+		memcpy(Dest,&Color,4);
+}
+
+static void FillBytes(unsigned char *Dest, int Color, long Count)
+{
+	for (; Count; --Count)
+		*Dest++ = (unsigned char)Color;
+}
+
+static void CopyRow(unsigned char *Dest, const unsigned char *Src, long Count)
+/*
+ * As CopyRow in PMGRAPH.ASM
+ */
+{
+	long Head;
+
+	if (Count >= 8) {
+		Head = -(long)(size_t)Dest & 3;
+		CopyBytes(Dest,Src,Head);
+		Dest += Head;
+		Src += Head;
+		Count -= Head;
+		CopyDwords(Dest,Src,Count >> 2);
+		Dest += Count & ~3;
+		Src += Count & ~3;
+		Count &= 3;
+	}
+	CopyBytes(Dest,Src,Count);
+}
+
+static void FillRow(unsigned char *Dest, int Color, long Count)
+/*
+ * As FillRow in PMGRAPH.ASM
+ */
+{
+	long Head;
+
+	if (Count >= 8) {
+		Head = -(long)(size_t)Dest & 3;
+		FillBytes(Dest,Color,Head);
+		Dest += Head;
+		Count -= Head;
+		FillDwords(Dest,Color * 0x01010101U,Count >> 2);
+		Dest += Count & ~3;
+		Count &= 3;
+	}
+	FillBytes(Dest,Color,Count);
+}
+
+static void OldPutImage(const TArea *Area)
+{
+	unsigned char *Dest;
+	const unsigned char *Src;
+	long Row;
+
+	Dest = Screen + Area->Top * GRWidth + Area->Left;
+	Src = Buffer;
+	for (Row = Area->Height; Row; --Row, Dest += GRWidth, Src += Area->Width) {
+		CopyDwords(Dest,Src,Area->Width >> 2);
+		CopyBytes(Dest + (Area->Width & ~3),Src + (Area->Width & ~3),Area->Width & 3);
+	}
+}
+
+static void NewPutImage(const TArea *Area)
+{
+	unsigned char *Dest;
+	const unsigned char *Src;
+	long Row;
+
+	Dest = Screen + Area->Top * GRWidth + Area->Left;
+	Src = Buffer;
+	if (Area->Width == GRWidth) {
+		CopyRow(Dest,Src,Area->Width * Area->Height);
+		return;
+	}
+	for (Row = Area->Height; Row; --Row, Dest += GRWidth, Src += Area->Width)
+		CopyRow(Dest,Src,Area->Width);
+}
+
+static void OldBuffer2Buffer(const TArea *Area)
+{
+	unsigned char *Dest;
+	const unsigned char *Src;
+	long Offset, Row, Half;
+
+	Offset = Area->Top * GRWidth + Area->Left;
+	Dest = Screen + Offset;
+	Src = Buffer + Offset;
+	for (Row = Area->Height; Row; --Row, Dest += GRWidth, Src += GRWidth) {
+		// rep movsw, then the odd byte
+		for (Half = 0; Half < (Area->Width & ~1); Half += 2)
+			memcpy(Dest + Half,Src + Half,2);
+		if (Area->Width & 1)
+			Dest[Half] = Src[Half];
+	}
+}
+
+static void NewBuffer2Buffer(const TArea *Area)
+{
+	unsigned char *Dest;
+	const unsigned char *Src;
+	long Offset, Row;
+
+	Offset = Area->Top * GRWidth + Area->Left;
+	Dest = Screen + Offset;
+	Src = Buffer + Offset;
+	if (Area->Width == GRWidth) {
+		CopyRow(Dest,Src,Area->Width * Area->Height);
+		return;
+	}
+	for (Row = Area->Height; Row; --Row, Dest += GRWidth, Src += GRWidth)
+		CopyRow(Dest,Src,Area->Width);
+}
+
+static void OldBar(const TArea *Area)
+{
+	unsigned char *Dest;
+	long Row;
+
+	Dest = Screen + Area->Top * GRWidth + Area->Left;
+	for (Row = Area->Height; Row; --Row, Dest += GRWidth) {
+		FillDwords(Dest,0x5a5a5a5aU,Area->Width >> 2);
+		FillBytes(Dest + (Area->Width & ~3),0x5a,Area->Width & 3);
+	}
+}
+
+static void NewBar(const TArea *Area)
+{
+	unsigned char *Dest;
+	long Row;
+
+	Dest = Screen + Area->Top * GRWidth + Area->Left;
+	if (Area->Width == GRWidth) {
+		FillRow(Dest,0x5a,Area->Width * Area->Height);
+		return;
+	}
+	for (Row = Area->Height; Row; --Row, Dest += GRWidth)
+		FillRow(Dest,0x5a,Area->Width);
+}
+
+static double Time(void (*Blit)(const TArea *), const TArea *Area, long Loops)
+/*
+ * Returns nanoseconds per pixel
+ */
+{
+	clock_t Start;
+	long Loop;
+
+	Start = clock();
+	for (Loop = 0; Loop < Loops; ++Loop)
+		Blit(Area);
+	return (double)(clock() - Start) / CLOCKS_PER_SEC * 1e9 / ((double)Loops * Area->Width * Area->Height);
+}
+
+static int Run(const char *Name, void (*OldBlit)(const TArea *), void (*NewBlit)(const TArea *), const TArea *Area)
+{
+	long Size, Loops;
+	double OldTime, NewTime;
+
+	Size = GRWidth * GRHeight;
+	memset(Screen,0,Size);
+	OldBlit(Area);
+	memcpy(Reference,Screen,Size);
+	memset(Screen,0,Size);
+	NewBlit(Area);
+	if (memcmp(Reference,Screen,Size) != 0) {
+		printf("%-12s %-10s: results differ\n",Name,Area->Name);
+		return -1;
+	}
+
+	// about 2^28 pixels each
+	Loops = (1L << 28) / (Area->Width * Area->Height) + 1;
+	OldTime = Time(OldBlit,Area,Loops);
+	NewTime = Time(NewBlit,Area,Loops);
+	printf("%-12s %-10s %4ldx%-4ld %8.3f %8.3f %6.2fx\n",Name,Area->Name,Area->Width,Area->Height,
+		OldTime,NewTime,NewTime > 0 ? OldTime / NewTime : 0.0);
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	TArea Areas[4];
+	int Index, Status;
+
+	GRWidth = argc > 2 ? atol(argv[1]) : 800;
+	GRHeight = argc > 2 ? atol(argv[2]) : 600;
+	if (GRWidth < 64 || GRHeight < 64) {
+		printf("usage: blitbnch [width height], at least 64x64\n");
+		return 1;
+	}
+	Screen = (unsigned char *)malloc(GRWidth * GRHeight);
+	Buffer = (unsigned char *)malloc(GRWidth * GRHeight);
+	Reference = (unsigned char *)malloc(GRWidth * GRHeight);
+	if (!Screen || !Buffer || !Reference) {
+		printf("out of memory\n");
+		return 1;
+	}
+	for (Index = 0; Index < GRWidth * GRHeight; ++Index)
+		Buffer[Index] = (unsigned char)(Index * 7 + 3);
+
+	// a button, a clipped window, a window and the whole screen
+	Areas[0].Name = "small";
+	Areas[0].Left = 3; Areas[0].Top = 5; Areas[0].Width = 37; Areas[0].Height = 19;
+	Areas[1].Name = "unaligned";
+	Areas[1].Left = 1; Areas[1].Top = 0; Areas[1].Width = GRWidth / 2 + 1; Areas[1].Height = GRHeight / 2;
+	Areas[2].Name = "aligned";
+	Areas[2].Left = 16; Areas[2].Top = 16; Areas[2].Width = GRWidth / 2; Areas[2].Height = GRHeight / 2;
+	Areas[3].Name = "full";
+	Areas[3].Left = 0; Areas[3].Top = 0; Areas[3].Width = GRWidth; Areas[3].Height = GRHeight;
+
+	printf("%ldx%ld, ns per pixel\n",GRWidth,GRHeight);
+	printf("%-12s %-10s %9s %8s %8s %7s\n","loop","area","size","old","new","speedup");
+	Status = 0;
+	for (Index = 0; Index < 4; ++Index) {
+		Status |= Run("PutImage",OldPutImage,NewPutImage,&Areas[Index]);
+		Status |= Run("Buffer2Buf",OldBuffer2Buffer,NewBuffer2Buffer,&Areas[Index]);
+		Status |= Run("Bar",OldBar,NewBar,&Areas[Index]);
+	}
+	free(Screen);
+	free(Buffer);
+	free(Reference);
+	return Status ? 1 : 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * Extended Operating System Loader (XOSL)
+ * Copyright (c) 1999 by Geurt Vos
+ *
+ * This code is distributed under GNU General Public License (GPL)
+ *
+ * The full text of the license can be found in the GPL.TXT file,
+ * or at http://www.gnu.org
+ */
+
+/*
+ * The font data is decoded once, when the font is first selected.
+ * Every glyph is plotted into Cell, once per style, after which the
+ * lit pixels are read back as spans. Drawing a string then only has
+ * to fill the spans, and the width of a string is a sum over Widths.
+ */
+
+#include <glyphs.h>
+#include <mem.h>
+
+unsigned char CGlyphAtlas::Cell[GLYPH_CELLHEIGHT][GLYPH_CELLWIDTH];
+
+CGlyphAtlas::CGlyphAtlas(const void *FontFile, const TFontEntry *FontHeader, const unsigned short *FontData, int TextHeight)
+{
+	int Index, Style;
+	unsigned short SpanCount;
+
+	this->FontFile = FontFile;
+	this->TextHeight = TextHeight;
+
+	// first pass only counts the spans
+	SpanCount = 0;
+	for (Index = 0; Index < 256; ++Index)
+		for (Style = 0; Style < GLYPH_STYLES; ++Style)
+			SpanCount += Decode(&FontHeader[Index],FontData,Style,NULL);
+	Spans = new TGlyphSpan[SpanCount];
+
+	SpanCount = 0;
+	for (Index = 0; Index < 256; ++Index) {
+		Widths[Index] = FontHeader[Index].Width;
+		for (Style = 0; Style < GLYPH_STYLES; ++Style) {
+			Glyphs[Style][Index].First = SpanCount;
+			Glyphs[Style][Index].Count = Decode(&FontHeader[Index],FontData,Style,&Spans[SpanCount]);
+			SpanCount += Glyphs[Style][Index].Count;
+		}
+	}
+}
+
+CGlyphAtlas::~CGlyphAtlas()
+{
+	delete[] Spans;
+}
+
+const void *CGlyphAtlas::GetFontFile()
+{
+	return FontFile;
+}
+
+int CGlyphAtlas::GetTextWidth(const char *Str, int Style)
+{
+	int Width;
+	const unsigned char *pStr;
+
+	pStr = (const unsigned char *)Str;
+	for (Width = 0; *pStr; Width += Widths[*pStr++]);
+	if (Style == STYLE_BOLD)
+		++Width;
+	return Width;
+}
+
+void CGlyphAtlas::Render(unsigned char *Sprite, int Width, int Height, int Left, int Top, const char *Str, int Style, int Color)
+/*
+ * An outlined string has to be drawn at Left - 1, Top - 1. Glyphs
+ * may reach below TextHeight and past their width, so the spans are
+ * clipped to the Width x Height sprite.
+ */
+{
+	const unsigned char *pStr;
+	const TGlyphEntry *Glyph;
+	const TGlyphSpan *Span, *SpanEnd;
+	int X, Y, End;
+
+	for (pStr = (const unsigned char *)Str; *pStr && Left < Width; ++pStr) {
+		Glyph = &Glyphs[Style][*pStr];
+		Span = &Spans[Glyph->First];
+		for (SpanEnd = Span + Glyph->Count; Span < SpanEnd; ++Span) {
+			Y = Top + Span->Top;
+			if (Y < 0 || Y >= Height)
+				continue;
+			X = Left + Span->Left;
+			End = X + Span->Length;
+			if (X < 0)
+				X = 0;
+			if (End > Width)
+				End = Width;
+			if (X < End)
+				memset(&Sprite[Y * Width + X],Color,End - X);
+		}
+		Left += Widths[*pStr];
+	}
+}
+
+unsigned short CGlyphAtlas::Decode(const TFontEntry *Entry, const unsigned short *FontData, int Style, TGlyphSpan *Dest)
+/*
+ * Returns the number of spans of the glyph. When Dest is NULL, they
+ * are only counted.
+ */
+{
+	const unsigned short *Data;
+	int Items, Width, Height;
+	int X, Y, Start;
+	unsigned short Count;
+
+	if ((Items = Entry->Items) == 0)
+		return 0;
+	Data = &FontData[(unsigned short)Entry->Index];
+
+	// only clear the part of Cell this glyph can reach
+	Width = 0;
+	Height = TextHeight;
+	for (X = 0; X < Items; ++X) {
+		if ((Data[X] >> 10) + (Data[X] & 0x1f) > Width)
+			Width = (Data[X] >> 10) + (Data[X] & 0x1f);
+		if (((Data[X] >> 5) & 0x1f) >= Height)
+			Height = ((Data[X] >> 5) & 0x1f) + 1;
+	}
+	Width += 2;
+	Height += 2;
+	for (Y = 0; Y < Height; ++Y)
+		memset(Cell[Y],0,Width + 1); // one extra, to end the last span
+
+	switch (Style) {
+		case STYLE_REGULAR:
+			Plot(Data,Items,0,0);
+			break;
+		case STYLE_BOLD:
+			Plot(Data,Items,0,0);
+			Plot(Data,Items,1,0);
+			break;
+		case GLYPH_OUTLINE:
+			Plot(Data,Items,0,0);
+			Plot(Data,Items,1,0);
+			Plot(Data,Items,2,0);
+			Plot(Data,Items,0,1);
+			Plot(Data,Items,2,1);
+			Plot(Data,Items,0,2);
+			Plot(Data,Items,1,2);
+			Plot(Data,Items,2,2);
+			break;
+	}
+
+	Count = 0;
+	for (Y = 0; Y < Height; ++Y)
+		for (X = 0; X < Width; ) {
+			if (!Cell[Y][X]) {
+				++X;
+				continue;
+			}
+			for (Start = X; Cell[Y][X]; ++X);
+			if (Dest) {
+				Dest->Left = Start;
+				Dest->Top = Y;
+				Dest->Length = X - Start;
+				++Dest;
+			}
+			++Count;
+		}
+	return Count;
+}
+
+void CGlyphAtlas::Plot(const unsigned short *Data, int Items, int Left, int Top)
+/*
+ * Each word of font data holds a horizontal run:
+ * bits 15-10 x, bits 9-5 y, bits 4-0 length.
+ */
+{
+	for (; Items; --Items, ++Data)
+		memset(&Cell[Top + ((*Data >> 5) & 0x1f)][Left + (*Data >> 10)],1,*Data & 0x1f);
+}
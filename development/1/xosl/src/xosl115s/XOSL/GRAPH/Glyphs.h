@@ -0,0 +1,64 @@
+/*
+ * Extended Operating System Loader (XOSL)
+ * Copyright (c) 1999 by Geurt Vos
+ *
+ * This code is distributed under GNU General Public License (GPL)
+ *
+ * The full text of the license can be found in the GPL.TXT file,
+ * or at http://www.gnu.org
+ */
+
+#ifndef __glyphs__
+#define __glyphs__
+
+#include <newdefs.h>
+#include <graph.h>
+
+// STYLE_REGULAR and STYLE_BOLD index the atlas as well
+#define GLYPH_OUTLINE 2
+#define GLYPH_STYLES  3
+
+// font data: x is 6 bits, y and length are 5 bits
+#define GLYPH_CELLWIDTH  (64 + 32 + 2)
+#define GLYPH_CELLHEIGHT (32 + 2)
+
+typedef struct {
+	unsigned char Left;
+	unsigned char Top;
+	unsigned char Length;
+} TGlyphSpan;
+
+typedef struct {
+	unsigned short First; // index in Spans
+	unsigned short Count;
+} TGlyphEntry;
+
+/*
+ * A font decoded once into horizontal spans per glyph and style.
+ * Bold glyphs have the extra pixel merged into their spans, outlined
+ * glyphs are the one pixel border around the regular glyph, in a cell
+ * that is one pixel larger at each side.
+ */
+class CGlyphAtlas {
+	public:
+		CGlyphAtlas(const void *FontFile, const TFontEntry *FontHeader, const unsigned short *FontData, int TextHeight);
+		~CGlyphAtlas();
+
+		const void *GetFontFile();
+		int GetTextWidth(const char *Str, int Style);
+		void Render(unsigned char *Sprite, int Width, int Height, int Left, int Top, const char *Str, int Style, int Color);
+
+	private:
+		unsigned short Decode(const TFontEntry *Entry, const unsigned short *FontData, int Style, TGlyphSpan *Dest);
+		static void Plot(const unsigned short *Data, int Items, int Left, int Top);
+
+		const void *FontFile;
+		int TextHeight;
+		unsigned char Widths[256];
+		TGlyphEntry Glyphs[GLYPH_STYLES][256];
+		TGlyphSpan *Spans;
+
+		static unsigned char Cell[GLYPH_CELLHEIGHT][GLYPH_CELLWIDTH];
+};
+
+#endif
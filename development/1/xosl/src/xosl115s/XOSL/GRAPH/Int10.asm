@@ -57,6 +57,51 @@ _SwitchTo       proc    far
                 retf
 _SwitchTo       endp
 
+;int SetDisplayStart(int Left, int Top)
+                public  _SetDisplayStart
+_SetDisplayStart proc   far
+                push    bp
+                mov     bp,sp
+                mov     ax,4f07h
+                xor     bx,bx
+                mov     cx,[bp + 6]
+                mov     dx,[bp + 8]
+                int     10h
+                xor     ax,004fh
+                pop     bp
+                retf
+_SetDisplayStart endp
+
+;unsigned long GetExtMemSize(void)
+;kb of memory above 1Mb, 0 when the BIOS can't tell
+                public  _GetExtMemSize
+_GetExtMemSize  proc    far
+                mov     ax,0e801h
+                xor     bx,bx
+                xor     cx,cx
+                xor     dx,dx
+                int     15h
+                jc      GEMOld
+                jcxz    GEMAxBx                 ;some BIOSes only set ax, bx
+                mov     ax,cx
+                mov     bx,dx
+GEMAxBx:        movzx   eax,ax                  ;kb up to 16Mb
+                movzx   ebx,bx                  ;64kb blocks above it
+                shl     ebx,6
+                add     eax,ebx
+                jz      GEMOld
+                mov     edx,eax
+                shr     edx,16
+                retf
+
+GEMOld:         mov     ah,88h
+                int     15h
+                jnc     GEMDone
+                xor     ax,ax
+GEMDone:        xor     dx,dx
+                retf
+_GetExtMemSize  endp
+
 FARCODE         ends
 
                 end
@@ -71,6 +71,8 @@ void far InitDesc(void);
 int far GetSVGAInfo(TSVGAInfo *SVGAInfo);
 int far GetModeInfo(int Mode, TModeInfo *ModeInfo);
 int far SwitchTo(unsigned short Mode);
+int far SetDisplayStart(int Left, int Top);
+unsigned long far GetExtMemSize(void);
 
 #ifdef __cplusplus
 };
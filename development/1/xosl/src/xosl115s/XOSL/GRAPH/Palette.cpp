@@ -9,7 +9,6 @@
  */
 
 #include <palette.h>
-#include <rgb.h>
 #include <mem.h>
 #include <graph.h>
 
@@ -19,8 +18,14 @@
 extern THSLPalette DefaultPalette[256];
 extern THSLPalette ColorSchemes[16][8];
 
+unsigned char CPalette::SatLumLUT[64][64];
+unsigned short CPalette::HueWeight[64];
+bool CPalette::LUTBuilt = false;
+
 CPalette::CPalette()
 {
+	if (!LUTBuilt)
+		BuildLUT();
 	Palette = new TPalette;
 	Scheme = 15;
 	Hue = 0;
@@ -28,6 +33,8 @@ CPalette::CPalette()
 	Alpha = 0;
 	Fading = false;
 	FadeColorInt = 100;
+	memset(Current,0,sizeof (Current));
+	Uploaded = false;
 }
 
 CPalette::~CPalette()
@@ -41,8 +48,23 @@ void CPalette::Install()
 	UpdatePalette();
 	if (!Fading)
 		InstallPalette();
-	else
+	else {
 		memcpy(PreFade,Palette,sizeof (TRGBPalette[256]));
+		if (!Uploaded) {
+			// the mode has changed, restore the faded colors
+			UploadAll(Current);
+			Uploaded = true;
+		}
+	}
+}
+
+void CPalette::Reinstall()
+/*
+ * After a mode switch the DAC no longer holds what was set
+ */
+{
+	Uploaded = false;
+	Install();
 }
 
 void CPalette::SetScheme(int Index)
@@ -117,49 +139,21 @@ void CPalette::UpdatePalette()
 
 void CPalette::SetPaletteEntry(int Index, int Red, int Green, int Blue)
 {
-	SetRGB(Index,Red,Green,Blue);
+	SetEntry(Index,Red,Green,Blue);
+	Graph->FlushPalette();
 }
 
 void CPalette::LockFading()
 {
-	int Index;
-
 	Fading = true;
 	PreFade = new TRGBPalette[256];
-	for (Index = 0; Index < 256; ++Index)
-		GetRGB(Index,PreFade[Index].Red,PreFade[Index].Green,PreFade[Index].Blue);
+	memcpy(PreFade,Current,sizeof (TRGBPalette[256]));
 }
 
 void CPalette::FadeIn()
 {
-	int Index;
-	int Red, Green, Blue;
-	int Progress;
-
 	Cli();
-	for (Progress = 0; Progress < 63; ++Progress) {
-		if ((Progress % 3) == 0)
-			Graph->WaitRetrace();
-		for (Index = 0; Index < 256; ++Index) {
-			GetRGB(Index,Red,Green,Blue);
-			if (Red != PreFade[Index].Red)
-				if (Red < PreFade[Index].Red)
-					++Red;
-				else
-					--Red;
-			if (Green != PreFade[Index].Green)
-				if (Green < PreFade[Index].Green)
-					++Green;
-				else
-					--Green;
-			if (Blue != PreFade[Index].Blue)
-				if (Blue < PreFade[Index].Blue)
-					++Blue;
-				else
-					--Blue;
-			SetRGB(Index,Red,Green,Blue);
-		}
-	}
+	Fade(PreFade,3);
 	Sti();
 	delete PreFade;
 	Fading = false;
@@ -167,45 +161,24 @@ void CPalette::FadeIn()
 
 void CPalette::FadeOut()
 {
-	int Red, Green, Blue;
-	int Index, Progress;
+	TRGBPalette *Target;
+	int Index;
 	int Color;
 
 	Color = (63 * FadeColorInt) / 100;
+	Target = new TRGBPalette[256];
+	for (Index = 0; Index < 256; ++Index)
+		Target[Index].Red = Target[Index].Green = Target[Index].Blue = Color;
 	Cli();
-	for (Progress = 0; Progress < 63; ++Progress) {
-		if ((Progress % 3) == 0)
-			Graph->WaitRetrace();
-		for (Index = 0; Index < 256; ++Index) {
-			GetRGB(Index,Red,Green,Blue);
-			if (Red != Color)
-				if (Red < Color)
-					++Red;
-				else
-					--Red;
-			if (Green != Color)
-				if (Green < Color)
-					++Green;
-				else
-					--Green;
-			if (Blue != Color)
-				if (Blue < Color)
-					++Blue;
-				else
-					--Blue;
-			SetRGB(Index,Red,Green,Blue);
-		}
-	}
+	Fade(Target,3);
 	Sti();
+	delete Target;
 }
 
 void CPalette::UltraFadeIn()
 {
-	int Index;
-
 	Graph->WaitRetrace();
-	for (Index = 0; Index < 256; ++Index)
-		SetRGB(Index,PreFade[Index].Red,PreFade[Index].Green,PreFade[Index].Blue);
+	UploadChanged(PreFade);
 	delete PreFade;
 	Fading = false;
 }
@@ -217,29 +190,84 @@ void CPalette::UltraFadeOut()
 	Color = (63 * FadeColorInt) / 100;
 	Graph->WaitRetrace();
 	for (Index = 0; Index < 256; ++Index)
-		SetRGB(Index,Color,Color,Color);
+		SetEntry(Index,Color,Color,Color);
+	Graph->FlushPalette();
 }
 
 void CPalette::FadeToBlack()
 {
-	int Index;
-	int Progress;
-	int Red, Green, Blue;
+	TRGBPalette *Target;
+
+	Target = new TRGBPalette[256];
+	memset(Target,0,sizeof (TRGBPalette[256]));
+	Fade(Target,8);
+	delete Target;
+}
+
+static int StepTo(int Value, int Target)
+{
+	if (Value < Target)
+		return Value + 1;
+	if (Value > Target)
+		return Value - 1;
+	return Value;
+}
+
+static int Distance(int Value, int Target)
+{
+	return Value < Target ? Target - Value : Value - Target;
+}
+
+void CPalette::Fade(const TRGBPalette *Target, int StepsPerRetrace)
+/*
+ * Each step moves every component one closer to Target, so an entry
+ * keeps changing for as many steps as its largest distance. With the
+ * entries ordered by that distance, a step only has to upload the
+ * first Changing[Step] of them.
+ */
+{
+	unsigned char Steps[256];
+	unsigned char Order[256];
+	int Count[64];
+	int Changing[65];
+	int Index, Entry, Step;
+	TRGBPalette *Color;
+
+	memset(Count,0,sizeof (Count));
+	for (Index = 0; Index < 256; ++Index) {
+		Step = Distance(Current[Index].Red,Target[Index].Red);
+		if (Distance(Current[Index].Green,Target[Index].Green) > Step)
+			Step = Distance(Current[Index].Green,Target[Index].Green);
+		if (Distance(Current[Index].Blue,Target[Index].Blue) > Step)
+			Step = Distance(Current[Index].Blue,Target[Index].Blue);
+		if (Step > 63)
+			Step = 63;
+		Steps[Index] = Step;
+		++Count[Step];
+	}
+	Changing[64] = 0;
+	for (Step = 63; Step >= 0; --Step)
+		Changing[Step] = Changing[Step + 1] + Count[Step];
+	// Count[Step] becomes the position in Order of the next entry with
+	// that distance, largest distances first
+	for (Step = 0; Step < 64; ++Step)
+		Count[Step] = Changing[Step + 1];
+	for (Index = 0; Index < 256; ++Index)
+		Order[Count[Steps[Index]]++] = Index;
 
-	for (Progress = 0; Progress < 63; ++Progress) {
-		if ((Progress & 7) == 0)
+	for (Step = 1; Step < 64 && Changing[Step]; ++Step) {
+		if ((Step - 1) % StepsPerRetrace == 0) {
 			Graph->WaitRetrace();
-		for (Index = 0; Index < 256; ++Index) {
-			GetRGB(Index,Red,Green,Blue);
-			if (--Red < 0)
-				Red = 0;
-			if (--Green < 0)
-				Green = 0;
-			if (--Blue < 0)
-				Blue = 0;
-			SetRGB(Index,Red,Green,Blue);
+			Graph->FlushPalette();
+		}
+		for (Index = 0; Index < Changing[Step]; ++Index) {
+			Entry = Order[Index];
+			Color = &Current[Entry];
+			SetEntry(Entry,StepTo(Color->Red,Target[Entry].Red),
+				StepTo(Color->Green,Target[Entry].Green),StepTo(Color->Blue,Target[Entry].Blue));
 		}
 	}
+	Graph->FlushPalette();
 }
 
 void CPalette::SetFadeOutColor(int Intensity)
@@ -249,65 +277,84 @@ void CPalette::SetFadeOutColor(int Intensity)
 
 void CPalette::InstallPalette()
 {
-	int Index;
-
 	Graph->WaitRetrace();
-	for (Index = 0; Index < 256; ++Index)
-		SetRGB(Index,Palette->RGBPalette[Index].Red,
-				 Palette->RGBPalette[Index].Green,Palette->RGBPalette[Index].Blue);
+	if (Uploaded)
+		UploadChanged(Palette->RGBPalette);
+	else {
+		UploadAll(Palette->RGBPalette);
+		Uploaded = true;
+	}
 }
 
-void CPalette::HSL2RGB(int &Red, int &Green, int &Blue, int Hue, int Saturation, int Luminance)
+void CPalette::UploadAll(const TRGBPalette *Colors)
 {
-	int Temp1, Temp2;
-	int RedTemp, GreenTemp, BlueTemp;
-
-	// 1
-	if (Saturation == 0)
-		Red = Green = Blue = Luminance;
-	else {
-		// 2
-		if (Luminance < 32)
-			Temp2 = (Luminance * (63 + Saturation)) / 63;
-		else
-			Temp2 = Luminance + Saturation - (Luminance * Saturation) / 63;
+	int Index;
 
-		// 3
-		Temp1 = 2 * Luminance - Temp2;
+	for (Index = 0; Index < 256; ++Index)
+		SetEntry(Index,Colors[Index].Red,Colors[Index].Green,Colors[Index].Blue);
+	Graph->FlushPalette();
+}
 
-		// 4
-		// Not necessary
+void CPalette::UploadChanged(const TRGBPalette *Colors)
+{
+	int Index;
 
-		// 5
+	for (Index = 0; Index < 256; ++Index)
+		if (Current[Index].Red != Colors[Index].Red ||
+			Current[Index].Green != Colors[Index].Green ||
+			Current[Index].Blue != Colors[Index].Blue)
+			SetEntry(Index,Colors[Index].Red,Colors[Index].Green,Colors[Index].Blue);
+	Graph->FlushPalette();
+}
 
-		RedTemp = Hue + 21;
-		GreenTemp = Hue;
-		BlueTemp = Hue - 21;
+void CPalette::SetEntry(int Index, int Red, int Green, int Blue)
+{
+	Current[Index].Red = Red;
+	Current[Index].Green = Green;
+	Current[Index].Blue = Blue;
+	Graph->SetPaletteColor(Index,Red,Green,Blue);
+}
 
-		if (RedTemp > 63)
-			RedTemp -= 64;
-		if (BlueTemp < 0)
-			BlueTemp += 64;
+void CPalette::HSL2RGB(int &Red, int &Green, int &Blue, int Hue, int Saturation, int Luminance)
+/*
+ * Temp2 is taken from SatLumLUT, and the weight of each hue from
+ * HueWeight. Both are built once, by BuildLUT().
+ */
+{
+	int Temp1, Temp2;
 
-		// 6
-		Red = GetColor(Temp1, Temp2, RedTemp);
-		Green = GetColor(Temp1, Temp2, GreenTemp);
-		Blue = GetColor(Temp1, Temp2, BlueTemp);
+	if (Saturation == 0) {
+		Red = Green = Blue = Luminance;
+		return;
 	}
-
-	// 7
-	// Not necessary
+	Temp2 = SatLumLUT[Saturation][Luminance];
+	Temp1 = 2 * Luminance - Temp2;
+	Red = Temp1 + ((long)(Temp2 - Temp1) * HueWeight[(Hue + 21) & 63]) / 3969;
+	Green = Temp1 + ((long)(Temp2 - Temp1) * HueWeight[Hue]) / 3969;
+	Blue = Temp1 + ((long)(Temp2 - Temp1) * HueWeight[(Hue - 21) & 63]) / 3969;
 }
 
-int CPalette::GetColor(long Temp1, long Temp2, long Temp3)
+void CPalette::BuildLUT()
 {
-	if (Temp3 < 11)
-		return Temp1 + ((Temp2 - Temp1) * 378 * Temp3) / 3969;
-	if (Temp3 < 32)
-		return Temp2;
-	if (Temp3 < 42)
-		return Temp1 + ((Temp2 - Temp1) * (42 - Temp3) * 378) / 3969;
-	return Temp1;
+	int Saturation, Luminance, Hue;
+
+	for (Saturation = 0; Saturation < 64; ++Saturation)
+		for (Luminance = 0; Luminance < 64; ++Luminance)
+			if (Luminance < 32)
+				SatLumLUT[Saturation][Luminance] = (Luminance * (63 + Saturation)) / 63;
+			else
+				SatLumLUT[Saturation][Luminance] = Luminance + Saturation - (Luminance * Saturation) / 63;
+
+	for (Hue = 0; Hue < 64; ++Hue)
+		if (Hue < 11)
+			HueWeight[Hue] = 378 * Hue;
+		else if (Hue < 32)
+			HueWeight[Hue] = 3969;
+		else if (Hue < 42)
+			HueWeight[Hue] = 378 * (42 - Hue);
+		else
+			HueWeight[Hue] = 0;
+	LUTBuilt = true;
 }
 
 void CPalette::MergeColors(TRGBPalette &Back, const TRGBPalette &Front, int Alpha)
@@ -13,6 +13,9 @@
 
 #include <newdefs.h>
 
+// skipped by PutSprite(), has to match SpriteKey in PMGRAPH.ASM
+#define SPRITE_KEY 0xff
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -21,8 +24,12 @@ void UltraFlush(void);
 void FlushArea(long Left, long Top, long Width, long Height);
 void UltraFlushVBE2(void);
 void FlushAreaVBE2(long Left, long Top, long Width, long Height);
+void FlushAreaLUT(long Left, long Top, long Width, long Height);
 void StoreBuffer(long Left, long Top, long Width, long Height);
 void RestoreBuffer(long Left, long Top, long Width, long Height);
+void MoveRows(long Left, long Top, long Width, long Height, long DestTop);
+void StoreCache(long Left, long Top, long Width, long Height);
+void RestoreCache(long Left, long Top, long Width, long Height);
 void PutPixel(long Left, long Top, long Color);
 void HLine(long Left, long Top, long Width, long Color);
 void VLine(long Left, long Top, long Height, long Color);
@@ -30,6 +37,8 @@ void Bar(long Left, long Top, long Width, long Height, long Color);
 void DrawText(long Left, long Top, long PhysStr, long Color);
 void PutImage(long Left, long Top, long Width, long Height, long IAdd, long PhysImage);
 void GetImage(long Left, long Top, long Width, long Height, long IAdd, long PhysImage);
+void PutSprite(long Left, long Top, long Width, long Height, long IAdd, long PhysImage);
+void PutRLEImage(long Left, long Top, long Width, long Height, long SkipLeft, long PhysRows, long PhysImage);
 
 void SetClippingRegion(long PhysLeft, long PhysTop, long PhysWidth, long PhysHeight);
 void GetClippingRegion(long PhysLeft, long PhysTop, long PhysWidth, long PhysHeight);
@@ -38,7 +47,6 @@ void GetViewportOrigin(long PhysLeft, long PhysTop);
 
 
 //extern void MapFontData();
-long PMTextWidth(long PhysStr);
 void CreateText(long Width, long PhysStr, long Color);
 //extern void CreateText(long Left, long Top, long PhysStr, long Color);
 
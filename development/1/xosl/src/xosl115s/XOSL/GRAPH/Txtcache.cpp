@@ -0,0 +1,123 @@
+/*
+ * Extended Operating System Loader (XOSL)
+ * Copyright (c) 1999 by Geurt Vos
+ *
+ * This code is distributed under GNU General Public License (GPL)
+ *
+ * The full text of the license can be found in the GPL.TXT file,
+ * or at http://www.gnu.org
+ */
+
+/*
+ * Sprites are allocated from a single pool. When either the pool or
+ * the entry table is full, the whole cache is dropped; the owner has
+ * to make sure no queued PutSprite() still refers to it (see
+ * CGraph::TextOut()).
+ */
+
+#include <txtcache.h>
+#include <pmgraph.h>
+#include <mem.h>
+#include <string.h>
+
+CTextCache::CTextCache()
+{
+	Pool = new unsigned char[TEXTCACHE_POOLSIZE];
+	Glyphs = NULL;
+	Clear();
+}
+
+CTextCache::~CTextCache()
+{
+	delete[] Pool;
+}
+
+void CTextCache::SetFont(CGlyphAtlas *Glyphs)
+{
+	this->Glyphs = Glyphs;
+	Clear();
+}
+
+void CTextCache::Clear()
+{
+	Count = 0;
+	PoolUsed = 0;
+}
+
+unsigned short CTextCache::HashStr(const char *Str)
+{
+	unsigned short Hash;
+
+	for (Hash = 0; *Str; ++Str)
+		Hash = (Hash << 5) + (Hash >> 11) + (unsigned char)*Str;
+	return Hash;
+}
+
+const TTextSprite *CTextCache::Find(const char *Str, int Style, int Color, int OutlineColor)
+{
+	unsigned short Hash;
+	int Index;
+	TTextSprite *Entry;
+
+	Hash = HashStr(Str);
+	for (Index = 0; Index < Count; ++Index) {
+		Entry = &Entries[Index];
+		if (Entry->Hash == Hash && Entry->Style == Style && Entry->Color == Color &&
+			Entry->OutlineColor == OutlineColor && strcmp(Entry->Str,Str) == 0)
+			return Entry;
+	}
+	return NULL;
+}
+
+int CTextCache::Fits(const char *Str, int Width, int Height)
+{
+	unsigned long Size;
+
+	Size = (unsigned long)Width * Height + strlen(Str) + 1;
+	return Count < TEXTCACHE_ENTRIES && Size <= TEXTCACHE_POOLSIZE - PoolUsed;
+}
+
+unsigned char *CTextCache::Allocate(unsigned short Size)
+{
+	unsigned char *Block;
+
+	Block = &Pool[PoolUsed];
+	PoolUsed += Size;
+	return Block;
+}
+
+const TTextSprite *CTextCache::Add(const char *Str, int Style, int Color, int OutlineColor, int Width, int Height)
+/*
+ * Width and Height include the outline and the extra bold pixel.
+ * Fits() has to be checked first.
+ */
+{
+	TTextSprite *Entry;
+	char *StrCopy;
+	int Length;
+
+	if ((unsigned long)Width * Height > TEXTCACHE_MAXSPRITE || !Fits(Str,Width,Height))
+		return NULL;
+	Entry = &Entries[Count++];
+	Entry->Hash = HashStr(Str);
+	Entry->Style = Style;
+	Entry->Color = Color;
+	Entry->OutlineColor = OutlineColor;
+	Entry->Width = Width;
+	Entry->Height = Height;
+
+	Length = strlen(Str) + 1;
+	StrCopy = (char *)Allocate(Length);
+	memcpy(StrCopy,Str,Length);
+	Entry->Str = StrCopy;
+
+	Entry->Sprite = Allocate(Width * Height);
+	memset(Entry->Sprite,SPRITE_KEY,Width * Height);
+	if (OutlineColor != -1) {
+		Glyphs->Render(Entry->Sprite,Width,Height,0,0,Str,GLYPH_OUTLINE,OutlineColor);
+		Glyphs->Render(Entry->Sprite,Width,Height,1,1,Str,STYLE_REGULAR,Color);
+	}
+	else
+		Glyphs->Render(Entry->Sprite,Width,Height,0,0,Str,Style,Color);
+	return Entry;
+}
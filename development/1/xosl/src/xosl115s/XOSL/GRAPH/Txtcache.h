@@ -0,0 +1,61 @@
+/*
+ * Extended Operating System Loader (XOSL)
+ * Copyright (c) 1999 by Geurt Vos
+ *
+ * This code is distributed under GNU General Public License (GPL)
+ *
+ * The full text of the license can be found in the GPL.TXT file,
+ * or at http://www.gnu.org
+ */
+
+#ifndef __txtcache__
+#define __txtcache__
+
+#include <newdefs.h>
+#include <graph.h>
+#include <glyphs.h>
+
+#define TEXTCACHE_ENTRIES  64
+#define TEXTCACHE_POOLSIZE 32768U
+// sprites larger than this are drawn the old way
+#define TEXTCACHE_MAXSPRITE (TEXTCACHE_POOLSIZE / 4)
+
+/*
+ * Strings rendered once into an 8bpp sprite. Pixels that are not part
+ * of the text have color SPRITE_KEY, and are skipped by PutSprite().
+ */
+typedef struct {
+	unsigned short Hash;
+	char Style;
+	unsigned char Color;
+	short OutlineColor; // -1: no outline
+	short Width, Height;
+	const char *Str;
+	unsigned char *Sprite;
+} TTextSprite;
+
+class CTextCache {
+	public:
+		CTextCache();
+		~CTextCache();
+
+		void SetFont(CGlyphAtlas *Glyphs);
+		void Clear();
+
+		const TTextSprite *Find(const char *Str, int Style, int Color, int OutlineColor);
+		int Fits(const char *Str, int Width, int Height);
+		const TTextSprite *Add(const char *Str, int Style, int Color, int OutlineColor, int Width, int Height);
+
+	private:
+		static unsigned short HashStr(const char *Str);
+		unsigned char *Allocate(unsigned short Size);
+
+		CGlyphAtlas *Glyphs;
+
+		TTextSprite Entries[TEXTCACHE_ENTRIES];
+		int Count;
+		unsigned char *Pool;
+		unsigned short PoolUsed;
+};
+
+#endif
@@ -26,9 +26,50 @@ long ScrnWidth, ScrnHeight;
 extern long TextHeight;
 
 unsigned long AddrLinearFB = 0;
+// page flipping: the page that isn't displayed, otherwise 0
+unsigned long AddrBackFB = 0;
+
+// 2 or 4: colors are translated through the LUT at PhysColorLUT
+long BytesPerPixel = 1;
+long BytesPerScanline;
+long PhysColorLUT;
+
+// offset of the row table in an RLE image (TRLEImage in GRAPH.H)
+#define RLE_ROWS 12
+
+#define BLOCK_GET    0
+#define BLOCK_PUT    1
+#define BLOCK_SPRITE 2
 
 static void VPBlockTransfer(long Left, long Top, long Width, long Height,
-									 long PhysImage, long Put);
+									 long PhysImage, long Mode);
+
+static int ClipArea(long *Left, long *Top, long *Width, long *Height)
+/*
+ * Moves the area to screen coordinates and clips it. Returns 0 when
+ * nothing is left.
+ */
+{
+	long Right, Bottom;
+
+	*Left += VPLeft;
+	*Top += VPTop;
+	if (*Left < ClipLeft) {
+		*Width -= ClipLeft - *Left;
+		*Left = ClipLeft;
+	}
+	Right = *Left + *Width - 1;
+	if (Right > ClipRight)
+		*Width -= Right - ClipRight;
+	if (*Top < ClipTop) {
+		*Height -= ClipTop - *Top;
+		*Top = ClipTop;
+	}
+	Bottom = *Top + *Height - 1;
+	if (Bottom > ClipBottom)
+		*Height -= Bottom - ClipBottom;
+	return *Width > 0 && *Height > 0;
+}
 
 void far InitViewport(long Width, long Height)
 {
@@ -45,94 +86,135 @@ void far InitVBE2(unsigned long Addr)
 	AddrLinearFB = Addr;
 }
 
+void far InitBackPage(unsigned long Addr)
+{
+	AddrBackFB = Addr;
+}
+
+void far InitPixelFormat(long PixelBytes, long ScanlineBytes, long PhysLUT)
+{
+	BytesPerPixel = PixelBytes;
+	BytesPerScanline = ScanlineBytes;
+	PhysColorLUT = PhysLUT;
+}
+
+static void FlushScreenArea(long Left, long Top, long Width, long Height)
+{
+	if (BytesPerPixel != 1)
+		FlushAreaLUT(Left,Top,Width,Height);
+	else
+		if (AddrLinearFB == 0)
+			FlushArea(Left,Top,Width,Height);
+		else
+			FlushAreaVBE2(Left,Top,Width,Height);
+}
+
+static void FlushBackArea(long Left, long Top, long Width, long Height)
+{
+	unsigned long AddrFrontFB;
+
+	AddrFrontFB = AddrLinearFB;
+	AddrLinearFB = AddrBackFB;
+	FlushScreenArea(Left,Top,Width,Height);
+	AddrLinearFB = AddrFrontFB;
+}
+
 void VPUltraFlush(void)
+/*
+ * With page flipping, goes to the back page. CGraph shows it.
+ */
 {
 	DrawCursor();
-	if (AddrLinearFB == 0)
-		UltraFlush();
+	if (AddrBackFB != 0)
+		FlushBackArea(0,0,ScrnWidth,ScrnHeight);
 	else
-		UltraFlushVBE2();
+		if (BytesPerPixel != 1)
+			FlushAreaLUT(0,0,ScrnWidth,ScrnHeight);
+		else
+			if (AddrLinearFB == 0)
+				UltraFlush();
+			else
+				UltraFlushVBE2();
 	ClearCursor();
 }
 
 void VPFlushArea(long Left, long Top, long Width, long Height)
 {
-	long Right, Bottom;
-
-	Left += VPLeft;
-	Top += VPTop;
-	if (Left < ClipLeft) {
-		Width -= ClipLeft - Left;
-		Left = ClipLeft;
-	}
-	Right = Left + Width - 1;
-	if (Right > ClipRight)
-		Width -= Right - ClipRight;
-	if (Top < ClipTop) {
-		Height -= ClipTop - Top;
-		Top = ClipTop;
-	}
-	Bottom = Top + Height - 1;
-	if (Bottom > ClipBottom)
-		Height -= Bottom - ClipBottom;
-	if (Width > 0 && Height > 0) {
+	if (ClipArea(&Left,&Top,&Width,&Height)) {
 		DrawCursor();
-		if (AddrLinearFB == 0)
-			FlushArea(Left,Top,Width,Height);
-		else
-			FlushAreaVBE2(Left,Top,Width,Height);
+		FlushScreenArea(Left,Top,Width,Height);
+		// keep both pages the same
+		if (AddrBackFB != 0)
+			FlushBackArea(Left,Top,Width,Height);
 		ClearCursor();
 	}
 }
 
-void VPStoreBuffer(long Left, long Top, long Width, long Height)
+void VPFlushDamage(long Left, long Top, long Width, long Height)
+/*
+ * Screen coordinates, already clipped to the screen by CGraph,
+ * so viewport and clipping region don't apply. With page flipping,
+ * goes to the back page.
+ */
 {
-	long Right, Bottom;
+	DrawCursor();
+	if (AddrBackFB != 0)
+		FlushBackArea(Left,Top,Width,Height);
+	else
+		FlushScreenArea(Left,Top,Width,Height);
+	ClearCursor();
+}
 
-	Left += VPLeft;
-	Top += VPTop;
-	if (Left < ClipLeft) {
-		Width -= ClipLeft - Left;
-		Left = ClipLeft;
-	}
-	Right = Left + Width - 1;
-	if (Right > ClipRight)
-		Width -= Right - ClipRight;
-	if (Top < ClipTop) {
-		Height -= ClipTop - Top;
-		Top = ClipTop;
-	}
-	Bottom = Top + Height - 1;
-	if (Bottom > ClipBottom)
-		Height -= Bottom - ClipBottom;
-	if (Width > 0 && Height > 0)
+void VPStoreBuffer(long Left, long Top, long Width, long Height)
+{
+	if (ClipArea(&Left,&Top,&Width,&Height))
 		StoreBuffer(Left,Top,Width,Height);
 }
 
 extern void VPRestoreBuffer(long Left, long Top, long Width, long Height)
 {
-	long Right, Bottom;
-
-	Left += VPLeft;
-	Top += VPTop;
-	if (Left < ClipLeft) {
-		Width -= ClipLeft - Left;
-		Left = ClipLeft;
-	}
-	Right = Left + Width - 1;
-	if (Right > ClipRight)
-		Width -= Right - ClipRight;
-	if (Top < ClipTop) {
-		Height -= ClipTop - Top;
-		Top = ClipTop;
-	}
-	Bottom = Top + Height - 1;
-	if (Bottom > ClipBottom)
-		Height -= Bottom - ClipBottom;
-	if (Width > 0 && Height > 0)
+	if (ClipArea(&Left,&Top,&Width,&Height))
 		RestoreBuffer(Left,Top,Width,Height);
 }
 
+void VPScrollArea(long Left, long Top, long Width, long Height, long Distance)
+/*
+ * Moves what is in the area Distance rows down, or up when negative.
+ * The rows that are uncovered keep what they had.
+ */
+{
+	if (!ClipArea(&Left,&Top,&Width,&Height))
+		return;
+	if (Distance >= Height || -Distance >= Height || !Distance)
+		return;
+	if (Distance > 0)
+		MoveRows(Left,Top,Width,Height - Distance,Top + Distance);
+	else
+		MoveRows(Left,Top - Distance,Width,Height + Distance,Top);
+}
+
+static int OnScreen(long Left, long Top, long Width, long Height)
+{
+	return Left >= 0 && Top >= 0 && Width > 0 && Height > 0 &&
+			 Left + Width <= ScrnWidth && Top + Height <= ScrnHeight;
+}
+
+void VPStoreCache(long Left, long Top, long Width, long Height)
+/*
+ * Screen coordinates, the viewport and clipping region don't apply.
+ * Areas that are not on the screen completely are ignored.
+ */
+{
+	if (OnScreen(Left,Top,Width,Height))
+		StoreCache(Left,Top,Width,Height);
+}
+
+void VPRestoreCache(long Left, long Top, long Width, long Height)
+{
+	if (OnScreen(Left,Top,Width,Height))
+		RestoreCache(Left,Top,Width,Height);
+}
+
 void VPPutPixel(long Left, long Top, long Color)
 {
 	Left += VPLeft;
@@ -191,76 +273,89 @@ void VPRectangle(long Left, long Top, long Width, long Height, long Color)
 
 void VPBar(long Left, long Top, long Width, long Height, long Color)
 {
-	long Right, Bottom;
-
-	Left += VPLeft;
-	Top += VPTop;
-	if (Left < ClipLeft) {
-		Width -= ClipLeft - Left;
-		Left = ClipLeft;
-	}
-	Right = Left + Width - 1;
-	if (Right > ClipRight)
-		Width -= Right - ClipRight;
-	if (Top < ClipTop) {
-		Height -= ClipTop - Top;
-		Top = ClipTop;
-	}
-	Bottom = Top + Height - 1;
-	if (Bottom > ClipBottom)
-		Height -= Bottom - ClipBottom;
-	if (Width > 0 && Height > 0)
+	if (ClipArea(&Left,&Top,&Width,&Height))
 		Bar(Left,Top,Width,Height,Color);
 }
 
 void VPPutImage(long Left, long Top, long Width, long Height, long PhysImage)
 {
-	VPBlockTransfer(Left,Top,Width,Height,PhysImage,true);
+	VPBlockTransfer(Left,Top,Width,Height,PhysImage,BLOCK_PUT);
 }
 
 void VPGetImage(long Left, long Top, long Width, long Height, long PhysImage)
 {
-	VPBlockTransfer(Left,Top,Width,Height,PhysImage,false);
+	VPBlockTransfer(Left,Top,Width,Height,PhysImage,BLOCK_GET);
 }
 
-static void VPBlockTransfer(long Left, long Top, long Width, long Height,
-									 long PhysImage, long Put)
+void VPPutSprite(long Left, long Top, long Width, long Height, long PhysImage)
 {
-	long IAdd;
-	long Bottom, Right;
+	VPBlockTransfer(Left,Top,Width,Height,PhysImage,BLOCK_SPRITE);
+}
 
-	Left += VPLeft;
-	Top += VPTop;
-	if (Top > ClipBottom || Left > ClipRight)
+void VPPutRLEImage(long Left, long Top, long Width, long Height, long PhysImage)
+/*
+ * Rows above the clipping region are skipped through the row table.
+ * Within a row, pixels left of it are decoded but not drawn.
+ */
+{
+	long FirstRow, SkipLeft;
+
+	SkipLeft = -(Left + VPLeft);
+	FirstRow = -(Top + VPTop);
+	if (!ClipArea(&Left,&Top,&Width,&Height))
 		return;
-	if (Top < ClipTop) {
-		PhysImage += (ClipTop - Top) * Width;
-		Height -= ClipTop - Top;
-		Top = ClipTop;
-	}
-	Bottom = Top + Height - 1;
-	if (Bottom > ClipBottom)
-		Height -= Bottom - ClipBottom;
+	SkipLeft += Left;
+	FirstRow += Top;
+	PutRLEImage(Left,Top,Width,Height,SkipLeft,
+					PhysImage + RLE_ROWS + FirstRow * 2,PhysImage);
+}
 
-	if (Left < ClipLeft) {
-		PhysImage += ClipLeft - Left;
-		IAdd = ClipLeft - Left;
-		Width -= IAdd;
-		Left = ClipLeft;
-	}
-	else
-		IAdd = 0;
+void VPTileImage(long Left, long Top, long Width, long TileSize, long PhysImage)
+/*
+ * Draws a single row of tiles, cut off at Left + Width. TileSize holds
+ * the height of the row in the high word, the width of a tile in the
+ * low word.
+ */
+{
+	long TileWidth, TileHeight;
+	long Right, PrevClipRight;
+
+	TileWidth = TileSize & 0xffff;
+	TileHeight = TileSize >> 16;
+	PrevClipRight = ClipRight;
+	Right = Left + VPLeft + Width - 1;
+	if (Right < ClipRight)
+		ClipRight = Right;
+	for (; Width > 0; Left += TileWidth, Width -= TileWidth)
+		VPBlockTransfer(Left,Top,TileWidth,TileHeight,PhysImage,BLOCK_PUT);
+	ClipRight = PrevClipRight;
+}
 
-	Right = Left + Width - 1;
-	if (Right > ClipRight) {
-		IAdd += Right - ClipRight;
-		Width -= Right - ClipRight;
-	}
-	if (Width > 0 && Height > 0)
-		if (Put)
+static void VPBlockTransfer(long Left, long Top, long Width, long Height,
+									 long PhysImage, long Mode)
+{
+	long ImageWidth, SkipLeft, SkipTop, IAdd;
+
+	ImageWidth = Width;
+	SkipLeft = -(Left + VPLeft);
+	SkipTop = -(Top + VPTop);
+	if (!ClipArea(&Left,&Top,&Width,&Height))
+		return;
+	SkipLeft += Left;
+	SkipTop += Top;
+	PhysImage += SkipTop * ImageWidth + SkipLeft;
+	IAdd = ImageWidth - Width;
+	switch (Mode) {
+		case BLOCK_PUT:
 			PutImage(Left,Top,Width,Height,IAdd,PhysImage);
-		else
+			break;
+		case BLOCK_SPRITE:
+			PutSprite(Left,Top,Width,Height,IAdd,PhysImage);
+			break;
+		default:
 			GetImage(Left,Top,Width,Height,IAdd,PhysImage);
+			break;
+	}
 }
 
 void VPLine(long X1, long Y1, long X2, long Y2, long Color)
@@ -310,13 +405,11 @@ void VPLine(long X1, long Y1, long X2, long Y2, long Color)
 	}
 }
 
-void VPTextOut(long Left, long Top, long PhysStr, long Color)
+void VPTextOut(long Left, long Top, long PhysStr, long Color, long Width)
+/*
+ * Width is taken from the width table in real mode
+ */
 {
-	long Width;
-
-	Width = PMTextWidth(PhysStr);
-
-
 	VPGetImage(Left,Top,Width,TextHeight,GrTextBuffer);
 	CreateText(Width,PhysStr,Color);
 	VPPutImage(Left,Top,Width,TextHeight,GrTextBuffer);
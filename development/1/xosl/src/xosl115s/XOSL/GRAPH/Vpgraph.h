@@ -19,8 +19,12 @@ extern "C" {
 
 void VPUltraFlush(void);
 void VPFlushArea(long Left, long Top, long Width, long Height);
+void VPFlushDamage(long Left, long Top, long Width, long Height);
 void VPStoreBuffer(long Left, long Top, long Width, long Height);
 void VPRestoreBuffer(long Left, long Top, long Width, long Height);
+void VPScrollArea(long Left, long Top, long Width, long Height, long Distance);
+void VPStoreCache(long Left, long Top, long Width, long Height);
+void VPRestoreCache(long Left, long Top, long Width, long Height);
 void VPPutPixel(long Left, long Top, long Color);
 void VPHLine(long Left, long Top, long Width, long Color);
 void VPVLine(long Left, long Top, long Height, long Color);
@@ -28,8 +32,11 @@ void VPRectangle(long Left, long Top, long Width, long Height, long Color);
 void VPBar(long Left, long Top, long Width, long Height, long Color);
 void VPPutImage(long Left, long Top, long Width, long Height, long PhysImage);
 void VPGetImage(long Left, long Top, long Width, long Height, long PhysImage);
+void VPPutSprite(long Left, long Top, long Width, long Height, long PhysImage);
+void VPPutRLEImage(long Left, long Top, long Width, long Height, long PhysImage);
+void VPTileImage(long Left, long Top, long Width, long TileSize, long PhysImage);
 void VPLine(long X1, long Y1, long X2, long Y2, long Color);
-void VPTextOut(long Left, long Top, long PhysStr, long Color);
+void VPTextOut(long Left, long Top, long PhysStr, long Color, long Width);
 
 #ifdef __cplusplus
 };
@@ -0,0 +1,227 @@
+/*
+ * Extended Operating System Loader (XOSL)
+ * Copyright (c) 1999 by Geurt Vos
+ *
+ * This code is distributed under GNU General Public License (GPL)
+ *
+ * The full text of the license can be found in the GPL.TXT file,
+ * or at http://www.gnu.org
+ */
+
+/*
+ * Host side encoder of run length encoded XBF bitmaps, the format
+ * PutRLEImage in PMGRAPH.ASM decodes (TRLEImage in GRAPH.H). It is not
+ * part of graph.lib. Build it with any C compiler:
+ *
+ *   cc -O2 -o xbfenc xbfenc.c
+ *   ./xbfenc width height key raw.xbf rle.xbf
+ *
+ * The input is a raw XBF: width x height bytes of palette indices, one
+ * row after the other. Pixels of color key become skipped runs, 0x100
+ * means the image has no transparent pixels. The shipped resources
+ * in ..\..\Resource were made from the raw dumps of XOSL 1.1.5 with:
+ *
+ *   xbfenc 218 146 0xfe  SPLASHLG.XBF SPLASHLG.XBF
+ *   xbfenc 218 146 0x100 XOSLLOGO.XBF XOSLLOGO.XBF
+ *   xbfenc 150 150 0x100 XOSLWALL.XBF XOSLWALL.XBF
+ *
+ * The result is decoded again and compared with the input before it
+ * is written.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define XBF_RLE_SIGNATURE 0x454c5258UL // "XRLE"
+#define RLE_HEADER 12 // up to the row table
+
+#define RLE_LITERAL 0x00 // n + 1 literal pixels, up to 128
+#define RLE_FILL    0x80 // next byte (n & 3fh) + 2 times, up to 65
+#define RLE_SKIP    0xc0 // (n & 3fh) + 1 pixels of Key, up to 64
+
+static unsigned char *Literal;
+static long LiteralCount;
+
+static void PutWord(unsigned char *Dest, unsigned short Value)
+{
+	Dest[0] = (unsigned char)Value;
+	Dest[1] = (unsigned char)(Value >> 8);
+}
+
+static unsigned short GetWord(const unsigned char *Src)
+{
+	return (unsigned short)(Src[0] | Src[1] << 8);
+}
+
+static long FlushLiteral(unsigned char *Dest)
+{
+	long Size, Count;
+	const unsigned char *Src;
+
+	Size = 0;
+	for (Src = Literal; LiteralCount; LiteralCount -= Count, Src += Count) {
+		Count = LiteralCount < 128 ? LiteralCount : 128;
+		Dest[Size++] = (unsigned char)(RLE_LITERAL | (Count - 1));
+		memcpy(&Dest[Size],Src,Count);
+		Size += Count;
+	}
+	return Size;
+}
+
+static long EncodeRow(const unsigned char *Row, int Width, int Key, unsigned char *Dest)
+/*
+ * Runs of 3 or more pixels are filled, shorter ones are literal.
+ * Returns the size of the encoded row.
+ */
+{
+	long Size, Count, Run;
+	int X, Start;
+
+	Size = 0;
+	LiteralCount = 0;
+	for (X = 0; X < Width; ) {
+		for (Start = X; X < Width && Row[X] == Row[Start]; ++X);
+		Count = X - Start;
+		if (Row[Start] == Key) {
+			Size += FlushLiteral(&Dest[Size]);
+			for (; Count; Count -= Run) {
+				Run = Count < 64 ? Count : 64;
+				Dest[Size++] = (unsigned char)(RLE_SKIP | (Run - 1));
+			}
+		}
+		else if (Count >= 3) {
+			Size += FlushLiteral(&Dest[Size]);
+			for (; Count >= 2; Count -= Run) {
+				Run = Count < 65 ? Count : 65;
+				Dest[Size++] = (unsigned char)(RLE_FILL | (Run - 2));
+				Dest[Size++] = Row[Start];
+			}
+			if (Count)
+				Literal[LiteralCount++] = Row[Start];
+		}
+		else
+			while (Count--)
+				Literal[LiteralCount++] = Row[Start];
+	}
+	return Size + FlushLiteral(&Dest[Size]);
+}
+
+static int Decode(const unsigned char *Image, unsigned char *Dest)
+/*
+ * Returns -1 when a row doesn't end where it should
+ */
+{
+	int Width, Height, Key, Row, X, Code, Count;
+	const unsigned char *Src;
+
+	Width = GetWord(&Image[4]);
+	Height = GetWord(&Image[6]);
+	Key = GetWord(&Image[8]);
+	for (Row = 0; Row < Height; ++Row) {
+		Src = &Image[GetWord(&Image[RLE_HEADER + Row * 2])];
+		for (X = 0; X < Width; X += Count) {
+			Code = *Src++;
+			if (Code < RLE_FILL) {
+				Count = Code + 1;
+				if (X + Count <= Width)
+					memcpy(Dest,Src,Count);
+				Src += Count;
+			}
+			else if (Code < RLE_SKIP) {
+				Count = (Code & 0x3f) + 2;
+				if (X + Count <= Width)
+					memset(Dest,*Src,Count);
+				++Src;
+			}
+			else {
+				Count = (Code & 0x3f) + 1;
+				if (X + Count <= Width)
+					memset(Dest,Key,Count);
+			}
+			Dest += Count;
+		}
+		if (X != Width)
+			return -1;
+	}
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	FILE *File;
+	unsigned char *Raw, *Image, *Check;
+	long Size, RawSize;
+	int Width, Height, Key, Row;
+
+	if (argc != 6) {
+		printf("usage: xbfenc width height key raw.xbf rle.xbf\n");
+		printf("key is the transparent color, 0x100 for none\n");
+		return 1;
+	}
+	Width = (int)strtol(argv[1],NULL,0);
+	Height = (int)strtol(argv[2],NULL,0);
+	Key = (int)strtol(argv[3],NULL,0);
+	if (Width < 1 || Width > 0xffff || Height < 1 || Height > 0xffff || Key < 0 || Key > 0x100) {
+		printf("xbfenc: bad width, height or key\n");
+		return 1;
+	}
+
+	RawSize = (long)Width * Height;
+	Raw = (unsigned char *)malloc(RawSize + 1);
+	Check = (unsigned char *)malloc(RawSize);
+	// worst case: a literal code per 128 pixels
+	Image = (unsigned char *)malloc(RLE_HEADER + Height * 2 + RawSize + RawSize / 128 + Height);
+	Literal = (unsigned char *)malloc(Width);
+	if (!Raw || !Check || !Image || !Literal) {
+		printf("xbfenc: out of memory\n");
+		return 1;
+	}
+
+	if ((File = fopen(argv[4],"rb")) == NULL) {
+		printf("xbfenc: can't open %s\n",argv[4]);
+		return 1;
+	}
+	Size = (long)fread(Raw,1,RawSize + 1,File);
+	fclose(File);
+	if (Size != RawSize || (GetWord(Raw) | (unsigned long)GetWord(&Raw[2]) << 16) == XBF_RLE_SIGNATURE) {
+		printf("xbfenc: %s is not a raw %dx%d XBF\n",argv[4],Width,Height);
+		return 1;
+	}
+
+	Size = RLE_HEADER + Height * 2;
+	for (Row = 0; Row < Height; ++Row) {
+		if (Size > 0xffff)
+			break;
+		PutWord(&Image[RLE_HEADER + Row * 2],(unsigned short)Size);
+		Size += EncodeRow(&Raw[(long)Row * Width],Width,Key,&Image[Size]);
+	}
+	// row offsets and the size are words
+	if (Size > 0xffff) {
+		printf("xbfenc: %s doesn't fit in 64k when encoded\n",argv[4]);
+		return 1;
+	}
+	PutWord(&Image[0],(unsigned short)XBF_RLE_SIGNATURE);
+	PutWord(&Image[2],(unsigned short)(XBF_RLE_SIGNATURE >> 16));
+	PutWord(&Image[4],(unsigned short)Width);
+	PutWord(&Image[6],(unsigned short)Height);
+	PutWord(&Image[8],(unsigned short)Key);
+	PutWord(&Image[10],(unsigned short)Size);
+
+	if (Decode(Image,Check) == -1 || memcmp(Check,Raw,RawSize) != 0) {
+		printf("xbfenc: %s doesn't decode to the input\n",argv[5]);
+		return 1;
+	}
+	if ((File = fopen(argv[5],"wb")) == NULL || fwrite(Image,1,Size,File) != (size_t)Size) {
+		printf("xbfenc: can't write %s\n",argv[5]);
+		return 1;
+	}
+	fclose(File);
+	printf("%s: %ld -> %ld bytes\n",argv[5],RawSize,Size);
+
+	free(Raw);
+	free(Check);
+	free(Image);
+	free(Literal);
+	return 0;
+}
@@ -16,12 +16,23 @@
 static const char *Title = "Extended Operating System Loader 1.1.5";
 static const char *SubTitle = "with Ranish Partition Manager 2.38 Beta 1.9";
 
+static const unsigned char Bayer[4][4] = {
+	{ 0, 8, 2,10},
+	{12, 4,14, 6},
+	{ 3,11, 1, 9},
+	{15, 7,13, 5}
+};
+
 CBackground::CBackground()
 {
+	TileCache = NULL;
+	StretchWallpaper = false;
+	CacheValid = false;
 }
 
 CBackground::~CBackground()
 {
+	delete[] TileCache;
 }
 
 void CBackground::SplashScreen(int Width, int Height)
@@ -31,7 +42,11 @@ void CBackground::SplashScreen(int Width, int Height)
 	Graph->Bar(0,0,Width,Height,0xfe);
 	Left = Width - SplashLogoWidth >> 1;
 	Top = Height - SplashLogoHeight >> 1;
-	Graph->PutImage(Left,Top,SplashLogoWidth,SplashLogoHeight,SplashLogo);
+	// the logo is drawn on a background of its own Key color
+	if (CGraph::IsRLEImage(SplashLogo))
+		Graph->PutRLEImage(Left,Top,SplashLogo,false);
+	else
+		Graph->PutImage(Left,Top,SplashLogoWidth,SplashLogoHeight,SplashLogo);
 }
 
 void CBackground::ShowSubTitle(int Width, int Height)
@@ -49,16 +64,37 @@ void CBackground::ShowSubTitle(int Width, int Height)
 
 
 void CBackground::NewGraphicsMode(int Width, int Height, int UseWallpaper)
+/*
+ * The background buffer of CGraph isn't used by anything else. As long
+ * as the screen size, the wallpaper and the font of the title are
+ * the same, it still holds the background and nothing is drawn.
+ */
 {
-	int X, Y;
 	int TitleLeft, TitleTop;
+	int Style;
 
-	if (UseWallpaper)
-		for (Y = 0; Y < Height; Y += WallpaperHeight)
-			for (X = 0; X < Width; X += WallpaperWidth)
-				Graph->PutImage(X,Y,WallpaperWidth,WallpaperHeight,Wallpaper);
+	if (!UseWallpaper)
+		Style = BGND_PLAIN;
 	else
-		Graph->Bar(0,0,Width,Height,16);
+		Style = StretchWallpaper ? BGND_SCALED : BGND_TILED;
+	if (CacheValid && CacheWidth == Width && CacheHeight == Height &&
+		 CacheStyle == Style && CacheFont == Graph->GetFont()) {
+		Graph->RestoreBuffer(0,0,Width,Height);
+		return;
+	}
+
+	switch (Style) {
+		case BGND_TILED:
+			Graph->TileImage(0,0,Width,Height,WallpaperWidth,WallpaperHeight,
+								  TileCache ? TileCache : Wallpaper);
+			break;
+		case BGND_SCALED:
+			DrawScaledWallpaper(Width,Height);
+			break;
+		default:
+			Graph->Bar(0,0,Width,Height,16);
+			break;
+	}
 
 	TitleLeft = Width - Graph->GetTextWidth(Title,STYLE_REGULAR) - 2;
 	TitleTop = Height - Graph->GetTextHeight() - 2;
@@ -66,19 +102,67 @@ void CBackground::NewGraphicsMode(int Width, int Height, int UseWallpaper)
 
 	Graph->StoreBuffer(0,0,Width,Height);
 
+	CacheValid = true;
+	CacheWidth = Width;
+	CacheHeight = Height;
+	CacheStyle = Style;
+	CacheFont = Graph->GetFont();
+}
+
+void CBackground::DrawScaledWallpaper(int Width, int Height)
+/*
+ * Bilinear scaling, except that palette indices can't be blended:
+ * each pixel takes one of its four source neighbours, picked by
+ * ordered dithering with the bilinear weights. The screen is drawn
+ * in bands, it doesn't fit in conventional memory.
+ */
+{
+	const unsigned char *Pixels, *Row0, *Row1;
+	unsigned short *Column; // source x
+	unsigned char *Weight;  // of source x + 1, in 1/16
+	unsigned char *Band, *Dest;
+	unsigned long Step, Pos;
+	int BandRows, BandTop, BandBottom;
+	int X, Y, WeightY;
+
+	Pixels = TileCache ? TileCache : Wallpaper;
+	Column = new unsigned short [Width];
+	Weight = new unsigned char [Width];
+	Step = ((unsigned long)(WallpaperWidth - 1) << 16) / (Width - 1);
+	for (X = 0, Pos = 0; X < Width; ++X, Pos += Step) {
+		Column[X] = (unsigned short)(Pos >> 16);
+		Weight[X] = (unsigned char)(Pos >> 12) & 15;
+	}
+
+	BandRows = (int)(32768U / (unsigned int)Width);
+	Band = new unsigned char [(unsigned int)(BandRows * Width)];
+	Step = ((unsigned long)(WallpaperHeight - 1) << 16) / (Height - 1);
+	Pos = 0;
+	for (BandTop = 0; BandTop < Height; BandTop = BandBottom) {
+		BandBottom = BandTop + BandRows;
+		if (BandBottom > Height)
+			BandBottom = Height;
+		Dest = Band;
+		for (Y = BandTop; Y < BandBottom; ++Y, Pos += Step) {
+			Row0 = &Pixels[(unsigned int)(Pos >> 16) * WallpaperWidth];
+			WeightY = (int)(Pos >> 12) & 15;
+			Row1 = WeightY ? Row0 + WallpaperWidth : Row0;
+			for (X = 0; X < Width; ++X)
+				*Dest++ = (WeightY > Bayer[X & 3][Y & 3] ? Row1 : Row0)
+							 [Column[X] + (Weight[X] > Bayer[Y & 3][X & 3])];
+		}
+		Graph->PutImage(0,BandTop,Width,BandBottom - BandTop,Band);
+		Graph->Sync();
+	}
+
+	delete[] Band;
+	delete[] Weight;
+	delete[] Column;
 }
 
 void CBackground::DrawBorderedText(int Left, int Top, const char *Text)
 {
-	Graph->TextOut(Left - 1,Top,Text,STYLE_REGULAR,0);
-	Graph->TextOut(Left + 1,Top,Text,STYLE_REGULAR,0);
-	Graph->TextOut(Left,Top - 1,Text,STYLE_REGULAR,0);
-	Graph->TextOut(Left,Top + 1,Text,STYLE_REGULAR,0);
-	Graph->TextOut(Left - 1,Top - 1,Text,STYLE_REGULAR,0);
-	Graph->TextOut(Left - 1,Top + 1,Text,STYLE_REGULAR,0);
-	Graph->TextOut(Left + 1,Top - 1,Text,STYLE_REGULAR,0);
-	Graph->TextOut(Left + 1,Top + 1,Text,STYLE_REGULAR,0);
-	Graph->TextOut(Left,Top,Text,STYLE_REGULAR,15);
+	Graph->TextOutOutlined(Left,Top,Text,15,0);
 }
 
 void CBackground::DrawTestScreen()
@@ -135,4 +219,16 @@ void CBackground::SetWallpaper(int Width, int Height, const unsigned char *Wallp
 	this->Wallpaper = Wallpaper;
 	WallpaperWidth = Width;
 	WallpaperHeight = Height;
+	delete[] TileCache;
+	TileCache = NULL;
+	CacheValid = false;
+	if (CGraph::IsRLEImage(Wallpaper)) {
+		TileCache = new unsigned char [(unsigned int)(Width * Height)];
+		CGraph::DecodeRLEImage(Wallpaper,TileCache);
+	}
+}
+
+void CBackground::SetStretchWallpaper(int StretchWallpaper)
+{
+	this->StretchWallpaper = StretchWallpaper;
 }
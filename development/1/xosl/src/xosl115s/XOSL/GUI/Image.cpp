@@ -52,14 +52,22 @@ void CImage::Draw(long, long, long, long)
 {
 	if (Image)
 		if (Border) {
-			Graph->PutImage(1,1,ImageWidth,ImageHeight,Image);
+			DrawImage(1,1);
 			Graph->Rectangle(0,0,Width,Height,17);
 		}
 		else
-			Graph->PutImage(0,0,ImageWidth,ImageHeight,Image);
+			DrawImage(0,0);
 	else {
 		Graph->Bar(0,0,Width,Height,Color);
 		if (Border)
 			Graph->Rectangle(0,0,Width,Height,17);
 	}
+}
+
+void CImage::DrawImage(int Left, int Top)
+{
+	if (CGraph::IsRLEImage(Image))
+		Graph->PutRLEImage(Left,Top,Image,true);
+	else
+		Graph->PutImage(Left,Top,ImageWidth,ImageHeight,Image);
 }
\ No newline at end of file
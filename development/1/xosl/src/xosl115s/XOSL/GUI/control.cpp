@@ -11,6 +11,7 @@
 #include <Control.h>
 #include <screen.h>
 #include <graph.h>
+#include <alloc.h>
 
 CControl::CControl(int Left, int Top, int Width, int Height,
 	int Visible, int OnTop, int FocusWnd, void *HandlerClass)
@@ -34,12 +35,35 @@ CControl::CControl(int Left, int Top, int Width, int Height,
 	this->HandlerClass = HandlerClass;
 	GotFocus = false;
 	PreFocus = true;
+	Listed = false;
+	IndexSlot = -1;
 }
 
 CControl::~CControl()
 {
 }
 
+void *CControl::operator new(unsigned int Size)
+{
+#ifdef ALLOC_PROFILE
+	// charge the control to whoever created it
+	return ProfiledAlloc(Size,RETURN_ADDRESS());
+#else
+	return ::operator new(Size);
+#endif
+}
+
+void *CControl::operator new(unsigned int Size, CArena &Arena)
+{
+	return Arena.Alloc(Size);
+}
+
+void CControl::operator delete(void *ptr)
+{
+	if (!CArena::Contains(ptr))
+		::operator delete(ptr);
+}
+
 void CControl::Show()
 {
 	if (Visible || !Parent)
@@ -143,10 +167,12 @@ void CControl::SetMetrics(int NewWidth, int NewHeight)
 	Height = NewHeight;
 	Right = Left + Width - 1;
 	Bottom = Top + Height - 1;
+	if (Parent)
+		Parent->UpdateIndex(this);
 	if (Visible && Parent) {
 		GetAbsPosition(DamageLeft,DamageTop);
 		Parent->FixDamage(Left,Top,DamageWidth,DamageHeight);
-		Graph->FlushArea(DamageLeft,DamageTop,DamageWidth,DamageHeight);
+		Graph->AddDamage(DamageLeft,DamageTop,DamageWidth,DamageHeight);
 	}
 }
 
@@ -171,6 +197,8 @@ void CControl::SetPosition(int Left, int Top)
 	this->Top = Top;
 	Right = Left + Width - 1;
 	Bottom = Top + Height - 1;
+	if (Parent)
+		Parent->UpdateIndex(this);
 	if (!Visible || !Parent)
 		return;
 
@@ -188,8 +216,8 @@ void CControl::SetPosition(int Left, int Top)
 	}
 
 	Parent->FixDamage(DamageLeft,DamageTop,DamageWidth,DamageHeight);
-	Graph->FlushArea(Left,Top,Width,Height);
-	Graph->FlushArea(OldLeft,OldTop,Width,Height);
+	Graph->AddDamage(Left,Top,Width,Height);
+	Graph->AddDamage(OldLeft,OldTop,Width,Height);
 }
 
 void CControl::GetPosition(int &Left, int &Top)
@@ -220,21 +248,19 @@ void CControl::Refresh()
 		return;
 	Parent->FixDamage(Left,Top,Width,Height);
 	GetAbsPosition(DamageLeft,DamageTop);
-	Graph->FlushArea(DamageLeft,DamageTop,Width,Height);
+	Graph->AddDamage(DamageLeft,DamageTop,Width,Height);
 }
 
 void CControl::FixDamage(int Left, int Top, int Width, int Height)
 {
 	int iAbsLeft, iAbsTop;
 //	long AbsLeft, AbsTop;
-	long VPLeft, VPTop;
-	long ClipLeft,ClipTop,ClipWidth,ClipHeight;
 //	long lLeft, lTop, lWidth, lHeight;
 
 	if (Visible && AdjustArea(Left,Top,Width,Height) != -1 && Parent) {
 		PreFocus = false;
-		Graph->GetClippingRegion(ClipLeft,ClipTop,ClipWidth,ClipHeight);
-		Graph->GetViewportOrigin(VPLeft,VPTop);
+		if (Graph->PushState() == -1)
+			return;
 
 		GetAbsPosition(iAbsLeft,iAbsTop);
 //		AbsLeft = iAbsLeft;
@@ -253,8 +279,7 @@ void CControl::FixDamage(int Left, int Top, int Width, int Height)
 
 		Draw(Left,Top,Width,Height);
 
-		Graph->SetViewportOrigin(VPLeft,VPTop);
-		Graph->SetClippingRegion(ClipLeft,ClipTop,ClipWidth,ClipHeight);
+		Graph->PopState();
 
 	}
 }
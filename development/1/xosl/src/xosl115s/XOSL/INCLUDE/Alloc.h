@@ -11,6 +11,35 @@
 #ifndef __alloc__
 #define __alloc__
 
+#include <mem.h>
+
+// tag every allocation with the address it was made from
+#ifdef DOS_DEBUG
+#define ALLOC_PROFILE
+#endif
+
+typedef struct {
+	long FreeBytes;   // in free blocks, CoreLeft()
+	long LargestFree; // largest free block
+	int FreeBlocks;
+	int PoolPages;    // pages holding objects up to 256 bytes
+	long PoolUsed;    // bytes of pool slots in use
+	long PoolFree;    // bytes of pool pages not in use
+} THeapStats;
+
 long CoreLeft();
+void GetHeapStats(THeapStats &Stats);
+#ifdef DOS_DEBUG
+// checks every block of the heap, -1: heap is corrupt
+int VerifyHeap();
+#endif
+#ifdef ALLOC_PROFILE
+// far return address of a function with a standard stack frame
+#define RETURN_ADDRESS() (*(unsigned long far *)MK_FP(_SS,_BP + 2))
+
+void *ProfiledAlloc(unsigned int Size, unsigned long Site);
+// per call site statistics and a map of all blocks
+void DumpHeap(const char *FileName);
+#endif
 
 #endif
\ No newline at end of file
@@ -0,0 +1,47 @@
+/*
+ * Extended Operating System Loader (XOSL)
+ * Copyright (c) 1999 by Geurt Vos
+ *
+ * This code is distributed under GNU General Public License (GPL)
+ *
+ * The full text of the license can be found in the GPL.TXT file,
+ * or at http://www.gnu.org
+ */
+
+#ifndef __arena__
+#define __arena__
+
+#include <newdefs.h>
+
+#define ARENA_CHUNKSIZE 4096
+#define ARENA_MAGIC     0xa3e7
+
+typedef struct SArenaChunk {
+	struct SArenaChunk *Next;
+	unsigned short Used; // offset of the first free byte
+	unsigned short Size;
+	char Reserved[6];
+	unsigned short MagicNum; // where a pool page has POOL_MAGIC
+} TArenaChunk;
+
+/*
+ * Memory for objects that all go at the same time, such as the
+ * controls of a dialog. Allocating only moves a pointer, nothing is
+ * freed until the arena is released or destroyed. Destructors of the
+ * objects are not called by the arena.
+ */
+class CArena {
+	public:
+		CArena(unsigned short ChunkSize = ARENA_CHUNKSIZE);
+		~CArena();
+		void *Alloc(unsigned short Size);
+		void Release();
+		// ptr was handed out by an arena
+		static int Contains(const void *ptr);
+
+	private:
+		TArenaChunk *Chunks;
+		unsigned short ChunkSize;
+};
+
+#endif
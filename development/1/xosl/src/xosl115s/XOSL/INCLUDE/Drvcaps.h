@@ -0,0 +1,47 @@
+/*
+ * Extended Operating System Loader (XOSL)
+ * Copyright (c) 1999 by Geurt Vos
+ *
+ * This code is distributed under GNU General Public License (GPL)
+ *
+ * The full text of the license can be found in the GPL.TXT file,
+ * or at http://www.gnu.org
+ */
+
+/*
+ * CDriveCaps
+ * BIOS capabilities of each drive, probed once on first use.
+ * Has to be flushed whenever the int 13h handler is replaced.
+ */
+
+#ifndef __drvcaps__
+#define __drvcaps__
+
+#include <newdefs.h>
+
+#define DRIVECAPS_FLOPPIES 4
+#define DRIVECAPS_FIXED    16
+
+typedef struct {
+	bool Probed;
+	bool Valid; // drive can be accessed at all
+	bool EddAvail; // int 13h extensions (LBA access)
+	bool Atapi; // EDD 3.0 device path reports an ATAPI device
+	int Heads;
+	int Sectors;
+	unsigned short MaxTransfer; // sectors per int 13h call
+	unsigned long TotalSectors; // 0 if unknown
+} TDriveCaps;
+
+class CDriveCaps {
+	public:
+		static const TDriveCaps &Get(int Drive);
+		static void Flush();
+	private:
+		static void Probe(int Drive, TDriveCaps &Caps);
+
+		static TDriveCaps Table[DRIVECAPS_FLOPPIES + DRIVECAPS_FIXED];
+		static TDriveCaps Unlisted;
+};
+
+#endif
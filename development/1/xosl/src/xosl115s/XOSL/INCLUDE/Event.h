@@ -0,0 +1,48 @@
+/*
+ * Extended Operating System Loader (XOSL)
+ * Copyright (c) 1999 by Geurt Vos
+ *
+ * This code is distributed under GNU General Public License (GPL)
+ *
+ * The full text of the license can be found in the GPL.TXT file,
+ * or at http://www.gnu.org
+ */
+
+#ifndef __event__
+#define __event__
+
+#include <newdefs.h>
+
+#define EVENT_NONE  0
+#define EVENT_KEY   1
+#define EVENT_MOUSE 2
+#define EVENT_TIMER 3
+
+#define EVENTQUEUE_SIZE 32 // power of 2
+
+typedef struct {
+	unsigned short Type;
+	unsigned short Data;
+} TEvent;
+
+/*
+ * Events are posted by the keyboard (int 9), mouse and timer (int 1ch)
+ * interrupts. They only tell that something happened: key strokes stay
+ * in the BIOS buffer and the mouse position is read from CMouse. When
+ * the queue is full, new events are dropped.
+ */
+class CEventQueue {
+	public:
+		static void Install();
+		static void Remove();
+		static void Post(int Type, int Data);
+
+		// halts the cpu until an event is available
+		static void WaitEvent(TEvent &Event);
+		// drops the queued events that are the same as Event
+		static void Coalesce(const TEvent &Event);
+		// flushes the queue, halts when it was empty
+		static void Idle();
+};
+
+#endif
@@ -65,6 +65,17 @@ class CForm: public CControl {
 
 		int oMoveLeft, oMoveTop;
 		int oMoveRight, oMoveBottom;
+
+	private:
+		// Moving with FrameMove off: the contents of the form are
+		// kept in the cache of CGraph, which holds one form at a time.
+		void StoreContents();
+		void DropContents();
+		int MoveCached(int Left, int Top);
+		void Place(int Left, int Top);
+		void FixUncovered(int OldLeft, int OldTop);
+		int OnScreen(int AbsLeft, int AbsTop);
+		static CForm *CacheOwner;
 };
 
 
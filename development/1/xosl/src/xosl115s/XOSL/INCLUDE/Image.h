@@ -23,6 +23,7 @@ class CImage: public CControl {
 		void SetColor(int Color);
 	private:
 		void Draw(long Left, long Top, long Width, long Height);
+		void DrawImage(int Left, int Top);
 		const void *Image;
 		int ImageWidth, ImageHeight;
 		int Border;
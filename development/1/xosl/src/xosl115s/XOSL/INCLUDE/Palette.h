@@ -35,6 +35,7 @@ class CPalette {
 		CPalette();
 		~CPalette();
 		void Install();
+		void Reinstall();
 		void SetScheme(int Index);
 		void SetHue(int Hue);
 		void SetSaturation(int Saturation);
@@ -53,10 +54,14 @@ class CPalette {
 		void CopyDefaultPalette();
 		void UpdatePalette();
 		void InstallPalette();
+		void UploadAll(const TRGBPalette *Colors);
+		void UploadChanged(const TRGBPalette *Colors);
+		void SetEntry(int Index, int Red, int Green, int Blue);
+		void Fade(const TRGBPalette *Target, int StepsPerRetrace);
 
 		void HSL2RGB(int &Red, int &Green, int &Blue,
 						 int Hue, int Saturation, int Luminance);
-		int GetColor(long Temp1, long Temp2, long Temp3);
+		static void BuildLUT();
 
       void MergeColors(TRGBPalette &Back, const TRGBPalette &Front, int Alpha);
 
@@ -66,11 +71,17 @@ class CPalette {
 		TRGBPalette ColorLayer;
 		int Alpha;
 		TPalette *Palette;
+		TRGBPalette Current[256]; // as last set, the DAC isn't read back
+		bool Uploaded; // false: the DAC may not hold Current
 
 		TRGBPalette *PreFade;
 		int Fading;
 
 		int FadeColorInt;
+
+		static unsigned char SatLumLUT[64][64]; // Temp2 of HSL2RGB()
+		static unsigned short HueWeight[64];    // in 1/3969
+		static bool LUTBuilt;
 };
 
 #endif
\ No newline at end of file
@@ -20,6 +20,11 @@
 #define PART_FLOPPY  3
 #define PART_SBM     4
 
+#define PARTSNAP_SIGNATURE 0x4e535058UL // "XPSN"
+#define PARTSNAP_MAXTABLES 56
+
+class CFileSystem;
+
 typedef struct {
 	unsigned char Activated;
 	unsigned char StartHead;
@@ -43,8 +48,40 @@ public:
 	short Drive;
 	short Type; // primary or logical
 	TPartTable *Table;
+	TPartEntry Shadow[4]; // entries as they are on disk
+	bool Dirty;
+	unsigned short Checksum; // of the complete sector as it is on disk
+	bool Cached; // restored from snapshot, only Entries are valid
+	char Labels[4][12]; // volume label of each entry
+	unsigned char LabelsRead; // bit n set: Labels[n] is valid
 };
 
+/*
+ * Snapshot of the partition structure, stored in PARTSNAP.XDF.
+ * On boot only the MBR of each drive is read and compared against
+ * the stored checksum. The EBR chains are taken from the snapshot.
+ * Volume labels are kept along with the table they belong to, so the
+ * setup dialogs don't have to read any boot sectors a second time.
+ */
+typedef struct {
+	unsigned long AbsoluteSector;
+	unsigned char Drive;
+	unsigned char Type;
+	unsigned short Checksum;
+	TPartEntry Entries[4];
+	unsigned char LabelsRead;
+	unsigned char Reserved;
+	char Labels[4][12];
+} TSnapTable; // sizeof(TSnapTable) == 122
+
+typedef struct {
+	unsigned long Signature;
+	unsigned short DriveCount;
+	unsigned short TableCount;
+	TSnapTable Tables[PARTSNAP_MAXTABLES];
+	char Reserved[1352]; // fill 8192 bytes
+} TPartSnapshot; // sizeof(TPartSnapshot) == 8192
+
 typedef struct {
 	short Drive;
 	unsigned long StartSector;
@@ -59,13 +96,18 @@ class CPartNode {
 public:
 	TPartEntry *Entry;
 	TPartition *Partition;
+	CMBRNode *MBRNode; // table holding Entry, NULL for non-partitions
 };
 
 class CPartList {
 	public:
-		CPartList();
+		CPartList(CFileSystem &FileSystemToUse);
 		~CPartList();
-		void WriteStructure();
+		int WriteStructure();
+		void InvalidateSnapshot();
+		// before Hide and SetActive, may read the structure again
+		int VerifyTables(int *Indices, int Count);
+		int GetSectorsWritten();
 		const TPartition *GetPartition(int Index);
 		int Locate(int Drive, unsigned long StartSector);
 		int GetCount();
@@ -77,7 +119,7 @@ class CPartList {
 		void SetAllowActiveHD(int Status);
 		void SetActive(int Index);
 
-		void ReadVolumeLabels();
+		void ReadVolumeLabels(int First, int Count);
 
 		void InsertMbrPTab(void *DestAddr);
 
@@ -98,6 +140,12 @@ class CPartList {
 		list<CPartNode> PartList;
 
 		void ReadStructure();
+		int LoadSnapshot();
+		void SaveSnapshot();
+		void FreeMBRList();
+		void FreeStructure();
+		int VerifyTable(CMBRNode *MBRNode);
+		static unsigned short SectorChecksum(const TPartTable *Table);
 
 		void AddDrive(int Drive, unsigned long StartSector, unsigned long ExtStart, int Type);
 		void CreatePartList(int FloppyCount);
@@ -105,13 +153,25 @@ class CPartList {
 		void CreateNonPartNode(int Drive);
 		
 		void CreatePLUP();
+		static unsigned short HashKey(int Drive, unsigned long StartSector);
+		void MarkDirty(int Index);
+		int WriteDrive(CMBRNode **Nodes, int Count);
+		static int MergeEntries(CMBRNode *MBRNode, const TPartTable *OnDisk);
 
 		CPartNode **PLUP;
+		// open addressing (Drive, StartSector) -> PLUP index, -1 when empty
+		short *PLUPHash;
+		unsigned short PLUPHashMask;
 		static const TFSNameEntry FSNameList[];
 		int AllowActiveHD;
 
 		bool PartListChanged;
-		bool VolumeLabelsRead;
+		bool LabelsChanged;
+		int SectorsWritten;
+
+		CFileSystem &FileSystem;
+		int FixedDriveCount;
+		bool SnapshotStale;
 
 };
 
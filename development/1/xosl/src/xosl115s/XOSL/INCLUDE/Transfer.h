@@ -28,6 +28,27 @@ typedef struct {
 	unsigned long SectorHigh;
 } TLBAPacket;
 
+// int 13h function 48h result buffer (EDD 3.0)
+typedef struct {
+	unsigned short BufferSize;
+	unsigned short InfoFlags;
+	unsigned long CylinderCount;
+	unsigned long HeadCount;
+	unsigned long SectorsPerTrack;
+	unsigned long TotalSectorCount[2];
+	unsigned short BytesPerSector;
+	unsigned long EddConfigParams;
+	unsigned short DevicePathSignature;
+	unsigned char DevicePathInfoLength;
+	unsigned char Reserved1[3];
+	unsigned char HostBusName[4]; // "ISA" or "PCI"
+	unsigned char InterfaceName[8]; // e.g. "ATAPI"
+	unsigned char InterfacePath[8];
+	unsigned char DevicePath[8];
+	unsigned char Reserved2;
+	unsigned char Checksum;
+} TExtDriveParams;
+
 class CDiskAccess {
 	public:
 		CDiskAccess();
@@ -38,12 +59,14 @@ class CDiskAccess {
 		int Transfer(int Action, unsigned short SectCyl,
 						 unsigned short DrvHead, void *Buffer, int Count);
 		int GetDriveInfo(int Drive, int &Heads, int &Sectors);
+		int GetDriveGeometry(int Drive, int &Cylinders, int &Heads, int &Sectors);
 		int CopyFromScratchpad(void *Buffer, int Sectors);
 		int CopyToScratchpad(const void *Buffer, int Sectors);
 
 		// lba stuff
 		int LBAAccessAvail(int Drive);
 		int LBATransfer(int Action, int Drive, const TLBAPacket &LBAPacket);
+		int GetExtDriveParams(int Drive, TExtDriveParams &Params);
 };
 
 #endif
@@ -14,6 +14,7 @@
 #include <newdefs.h>
 #include <wndlist.h>
 #include <cstring.h>
+#include <arena.h>
 
 /*
  * HandlerClass: pointer to class of the
@@ -30,6 +31,11 @@ class CControl {
 	public:
 		CControl(int Left, int Top, int Width, int Height, int Visible, int OnTop, int FocusWnd, void *HandlerClass);
 		virtual ~CControl();
+		// new (Arena) CButton(...) puts a control in an arena, delete
+		// then only calls the destructor
+		void *operator new(unsigned int Size);
+		void *operator new(unsigned int Size, CArena &Arena);
+		void operator delete(void *ptr);
 		virtual void Show();
 		virtual void Hide();
 		void SetVisible(int Visible);
@@ -70,6 +76,14 @@ class CControl {
 		TWndOnShow WndOnShow;
 		TWndOnHide WndOnHide;
 		int FocusWnd;
+
+		// maintained by CWindowList
+		list<CControl *>::iterator DrawEntry;
+		list<CControl *>::iterator TabEntry;
+		int Listed;
+		int IndexSlot; // -1: not in the hit-test index
+		int CellLeft, CellTop, CellRight, CellBottom;
+		unsigned long ZOrder;
 	protected:
 		TWndOnKeyPress WndOnKeyPress;
 		int AdjustArea(int &iLeft, int &iTop, int &iWidth, int &iHeight);
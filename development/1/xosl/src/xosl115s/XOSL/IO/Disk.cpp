@@ -11,6 +11,7 @@
 #include <disk.h>
 #include <mem.h>
 #include <transfer.h>
+#include <drvcaps.h>
 
 CDisk::CDisk()
 {
@@ -29,19 +30,17 @@ int CDisk::DriveCount(int Fixed)
 
 int CDisk::Map(int Drive, long StartSector)
 {
-	int Status;
+	const TDriveCaps &Caps = CDriveCaps::Get(Drive);
 
 	this->Drive = Drive;
 	this->StartSector = StartSector;
-	if (Drive >= 0x80 && DiskAccess.LBAAccessAvail(Drive) == 0)
-		UseLBA = 1;
-	else {
-		if (DiskAccess.GetDriveInfo(Drive,DrvHeadCount,DrvSectorCount) == -1) {
-			DiskMapped = 0;
-			return -1;
-		}
-		UseLBA = 0;
+	if (!Caps.Valid) {
+		DiskMapped = 0;
+		return -1;
 	}
+	UseLBA = Caps.EddAvail;
+	DrvHeadCount = Caps.Heads;
+	DrvSectorCount = Caps.Sectors;
 	DiskMapped = 1;
 	return 0;
 }
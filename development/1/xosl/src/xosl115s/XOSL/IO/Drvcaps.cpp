@@ -0,0 +1,72 @@
+/*
+ * Extended Operating System Loader (XOSL)
+ * Copyright (c) 1999 by Geurt Vos
+ *
+ * This code is distributed under GNU General Public License (GPL)
+ *
+ * The full text of the license can be found in the GPL.TXT file,
+ * or at http://www.gnu.org
+ */
+
+#include <drvcaps.h>
+#include <transfer.h>
+#include <mem.h>
+
+#define EDD_MAX_TRANSFER 127
+
+TDriveCaps CDriveCaps::Table[DRIVECAPS_FLOPPIES + DRIVECAPS_FIXED];
+TDriveCaps CDriveCaps::Unlisted;
+
+const TDriveCaps &CDriveCaps::Get(int Drive)
+{
+	int Index;
+
+	if (Drive >= 0x80)
+		Index = Drive - 0x80 + DRIVECAPS_FLOPPIES;
+	else
+		Index = Drive;
+	if (Index >= DRIVECAPS_FLOPPIES + DRIVECAPS_FIXED || (Drive < 0x80 && Index >= DRIVECAPS_FLOPPIES)) {
+		// not worth caching
+		Probe(Drive,Unlisted);
+		return Unlisted;
+	}
+	if (!Table[Index].Probed)
+		Probe(Drive,Table[Index]);
+	return Table[Index];
+}
+
+void CDriveCaps::Flush()
+{
+	memset(Table,0,sizeof (Table));
+}
+
+void CDriveCaps::Probe(int Drive, TDriveCaps &Caps)
+{
+	CDiskAccess DiskAccess;
+	TExtDriveParams Params;
+	int Cylinders;
+	int GeometryStatus;
+
+	memset(&Caps,0,sizeof (TDriveCaps));
+	Caps.Probed = true;
+	GeometryStatus = DiskAccess.GetDriveGeometry(Drive,Cylinders,Caps.Heads,Caps.Sectors);
+	if (Drive >= 0x80 && DiskAccess.LBAAccessAvail(Drive) == 0) {
+		Caps.Valid = true;
+		Caps.EddAvail = true;
+		Caps.MaxTransfer = EDD_MAX_TRANSFER;
+		memset(&Params,0,sizeof (TExtDriveParams));
+		Params.BufferSize = sizeof (TExtDriveParams);
+		if (DiskAccess.GetExtDriveParams(Drive,Params) != -1) {
+			if (!Params.TotalSectorCount[1])
+				Caps.TotalSectors = Params.TotalSectorCount[0];
+			Caps.Atapi = Params.DevicePathSignature == 0xbedd &&
+				Params.DevicePathInfoLength == 36 &&
+				memcmp(Params.InterfaceName,"ATAPI",5) == 0;
+		}
+	}
+	else if (GeometryStatus != -1) {
+		Caps.Valid = true;
+		Caps.MaxTransfer = Caps.Sectors;
+		Caps.TotalSectors = (unsigned long)Cylinders * Caps.Heads * Caps.Sectors;
+	}
+}
@@ -14,6 +14,7 @@
 
                 public  @CDiskAccess@LBAAccessAvail$qi
                 public  @CDiskAccess@LBATransfer$qiimx10TLBAPacket
+                public  @CDiskAccess@GetExtDriveParams$qim15TExtDriveParams
 
 ;int CDiskAccess::LBAAccessAvail(int Drive)
 @CDiskAccess@LBAAccessAvail$qi proc c
@@ -53,6 +54,23 @@ LBA_AAEnd:      ret
                 ret
                 endp
 
+;int CDiskAccess::GetExtDriveParams(int Drive, TExtDriveParams &Params)
+@CDiskAccess@GetExtDriveParams$qim15TExtDriveParams proc c
+                arg     @@this: dword, @@Drive: word
+                arg     @@Params: dword
+
+                push    si ds
+
+                mov     ah,48h
+                mov     dl,byte ptr @@Drive
+                lds     si,@@Params
+                int     13h
+                sbb     ax,ax
+
+                pop     ds si
+                ret
+                endp
+
 
 
 		end
@@ -20,6 +20,7 @@ Scratchpad      dd      00008000h
                 public  @CDiskAccess@DriveCount$qi
                 public  @CDiskAccess@Transfer$qiususnvi
                 public  @CDiskAccess@GetDriveInfo$qimit2
+                public  @CDiskAccess@GetDriveGeometry$qimit2t2
                 public  @CDiskAccess@CopyFromScratchpad$qnvi
                 public  @CDiskAccess@CopyToScratchpad$qnxvi
 
@@ -118,6 +119,35 @@ TransDone:      ret
                 ret
                 endp
 
+;int CDiskAccess::GetDriveGeometry(int Drive, int &Cylinders, int &Heads, int &Sectors);
+@CDiskAccess@GetDriveGeometry$qimit2t2 proc c
+                arg     @@this: dword, @@Drive: word
+                arg     @@Cylinders: dword, @@Heads: dword, @@Sectors: dword
+
+		push    di
+
+		mov     ah,8
+                mov     dl,byte ptr @@Drive
+		int     13h
+                sbb     ax,ax
+                les     bx,@@Sectors
+		movzx   di,cl
+		and     di,3fh
+		mov     es:[bx],di
+                les     bx,@@Cylinders
+		shr     cl,6
+		xchg    cl,ch
+		inc     cx
+		mov     es:[bx],cx
+                les     bx,@@Heads
+		shr     dx,8
+		inc     dx
+		mov     es:[bx],dx
+
+		pop     di
+                ret
+                endp
+
 ;void CDiskAccess::CopyFromScratchpad(void *Buffer, int Sectors)
 @CDiskAccess@CopyFromScratchpad$qnvi proc c
                 arg     @@this: dword, @@Buffer: dword, @@Sectors: word
@@ -2,27 +2,7 @@
 #include "cdrom.h"
 #include <fs.h>
 #include <mem.h>
-    
-class CExtDriveParams {
-public:
-	unsigned short BufferSize;
-	unsigned short InfoFlags;
-	unsigned long CylinderCount;
-	unsigned long HeadCount;
-	unsigned long SectorsPerTrack;
-	unsigned long TotalSectorCount[2];
-	unsigned short BytesPerSector;
-	unsigned long EddConfigParams;
-	unsigned short DevicePathSignature;
-	unsigned char DevicePathInfoLength;
-	unsigned char Reserved1[3];
-	unsigned char HostBusName[4]; // "ISA" or "PCI"
-	unsigned char InterfaceName[8]; // e.g. "ATAPI"
-	unsigned char InterfacePath[8];
-	unsigned char DevicePath[8];
-	unsigned char Reserved2;
-	unsigned char Checksum;
-};
+#include <drvcaps.h>
 
 void printf(const char *,...);
 
@@ -63,6 +43,8 @@ int CCdRom::Install(short IdePort1, short IdePort2)
 		CallBootExtension(BootExtensionAddr,funcInitAtapi,0,0);
 		printf("InstInt13\n");
 		CallBootExtension(BootExtensionAddr,funcInstInt13,0,0);
+		// int 13h handler replaced
+		CDriveCaps::Flush();
 	}
 	return 0;
 }
@@ -73,6 +55,7 @@ void CCdRom::Uninstall()
 		CallBootExtension(BootExtensionAddr,funcUninstInt13,0,0);
 		FreeConvMem(SIZE_OF_EDD30);
 		BootExtensionAddr = 0;
+		CDriveCaps::Flush();
 	}
 }
 
@@ -82,23 +65,7 @@ bool CCdRom::IsDriveCdRom(int Drive)
 	if (!BootExtensionAddr) {
 		return false;
 	}
-	CExtDriveParams ExtDriveParams;
-	ExtDriveParams.BufferSize = sizeof(CExtDriveParams);
-	if (GetExtDriveParams(Drive,ExtDriveParams) == -1) {
-		return false;
-	}
-
-	if (ExtDriveParams.DevicePathSignature != 0xbedd) {
-		return false;
-	}
-	if (ExtDriveParams.DevicePathInfoLength != 36) {
-		return false;
-	}
-	
-	if (memcmp(ExtDriveParams.InterfaceName,"ATAPI",5) != 0) {
-		return false;
-	}
-	return true;
+	return CDriveCaps::Get(Drive).Atapi;
 }
 
 unsigned long CCdRom::AllocConvMem(int KbCount)
@@ -18,7 +18,6 @@
 #include <newdefs.h>
 
 class CFileSystem;
-class CExtDriveParams;
 
 class CCdRom {
 public:
@@ -46,8 +45,6 @@ private:
 	int LoadBootExtension();
 	void CallBootExtension(unsigned long Address, int Func, 
 						   unsigned short BX, unsigned short CX);
-
-	int GetExtDriveParams(int Drive, CExtDriveParams &Params);
 };
 
 
@@ -9,11 +9,51 @@
  */
 
 /*
- * Basic 'First Fit' allocation unit
+ * Allocation unit
+ *
+ * Memory is handed out in blocks of paragraphs, each starting with a
+ * TMemDesc. A free block also has its size in the first word of its
+ * last paragraph, and the block after it has MEM_PREVFREE set, so both
+ * neighbours of a block are found without searching. Free blocks are
+ * kept in bins by size, bin n holds 2^n up to 2^(n + 1) - 1 paragraphs.
+ *
+ * Requests up to POOL_MAXSIZE bytes are served from pool pages, one
+ * size class per page. A block always starts at offset 0 of its
+ * segment, while a pool slot never does: delete can tell them apart
+ * by the offset alone. The pool page header is at offset 0 of the
+ * segment of the slot.
+ *
+ * With ALLOC_PROFILE every allocation is 4 bytes larger and ends in a
+ * TAllocTag, which holds the index of the call site in Sites and the
+ * size as requested. The call site is the return address of new.
  */
 
 #include <newdefs.h>
 #include <mem.h>
+#include <alloc.h>
+#ifdef ALLOC_PROFILE
+#include <string.h>
+#include <..\debug\dosfile.h>
+#endif
+
+#define MEM_MAGIC    0xabcd0123UL
+#define MEM_FREE     0x0001
+#define MEM_PREVFREE 0x0002
+#define MEM_BINS     16
+// header and footer of a free block
+#define MEM_MINPAGES 2
+
+// the block Count paragraphs further, or back when negative
+#define MEM_MOVE(Desc,Count) ((PMemDesc)((long)(Desc) + ((long)(Count) << 16)))
+#define MEM_FOOTER(Desc) (*(unsigned short *)MEM_MOVE(Desc,(Desc)->PageCount - 1))
+
+#define POOL_PAGESIZE 2048
+#define POOL_MAXSIZE  256
+#define POOL_CLASSES  8
+#define POOL_MAGIC    0x5a17
+
+// power of 2, site 0 takes what doesn't fit
+#define PROFILE_SITES 256
 
 static void wait()
 {
@@ -24,113 +64,579 @@ extern void printf(const char *fmt, ...);
 
 
 typedef struct SMemDesc {
-	struct SMemDesc *Next;
+	struct SMemDesc *Next; // bin of a free block
 	struct SMemDesc *Prev;
-	long PageCount;
-	unsigned long MagicNum; // 0xabcd0123
+	unsigned short PageCount; // header included
+	unsigned short Flags;
+	unsigned long MagicNum; // MEM_MAGIC
 } TMemDesc, *PMemDesc;
 
-static PMemDesc FreeList;
+typedef struct SPoolPage {
+	struct SPoolPage *Next; // pages of the class with a free slot
+	struct SPoolPage *Prev;
+	unsigned short FreeSlot; // offset, 0: page is full
+	unsigned short Used;
+	unsigned short Class;
+	unsigned short MagicNum; // POOL_MAGIC
+} TPoolPage, *PPoolPage;
+
+static PMemDesc Bins[MEM_BINS];
+static unsigned short BinMask; // bit n set: Bins[n] isn't empty
+static PMemDesc HeapStart;
+static PMemDesc HeapEnd; // last paragraph, a block that is never free
+
+static PPoolPage PoolPages[POOL_CLASSES];
+static const unsigned short ClassSize[POOL_CLASSES] = {
+	16, 32, 48, 64, 96, 128, 192, 256
+};
+// indexed by the size in paragraphs, rounded up
+static const unsigned char SizeClass[POOL_MAXSIZE / 16 + 1] = {
+	0, 0, 1, 2, 3, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7
+};
+static int PoolPageCount;
+static long PoolBytesUsed;
+
+#ifdef ALLOC_PROFILE
+typedef struct {
+	unsigned short Site; // index in Sites
+	unsigned short Size; // as requested
+} TAllocTag;
+
+typedef struct {
+	unsigned long Address; // 0: unused
+	unsigned short Count; // live allocations
+	unsigned long Allocs;
+	long Bytes; // live bytes
+	long Peak;
+} TAllocSite;
+
+static TAllocSite Sites[PROFILE_SITES];
+
+static unsigned short FindSite(unsigned long Address);
+static TAllocTag *GetTag(void *ptr);
+static int IsAllocated(void *ptr);
+static void DumpText(int Handle, const char *Str);
+static void DumpNumber(int Handle, long Value, int Base, int Width);
+static void DumpAddress(int Handle, unsigned long Address);
+#endif
+
+static void *Allocate(unsigned int Size);
+static void *BlockAlloc(unsigned int Size);
+static void BlockFree(void *ptr);
+static PMemDesc FindFree(unsigned short PageCount);
+static int GetBin(unsigned short PageCount);
+static void BinInsert(PMemDesc Desc);
+static void BinRemove(PMemDesc Desc);
+static void *PoolAlloc(int Class);
+static void PoolFree(void *ptr);
+static PPoolPage NewPoolPage(int Class);
+static void LinkPoolPage(PPoolPage Page);
+static void UnlinkPoolPage(PPoolPage Page);
 
 void AllocInit(unsigned long MemStart)
 {
-	PMemDesc NextItem;
+	int Bin;
+
+	for (Bin = 0; Bin < MEM_BINS; ++Bin)
+		Bins[Bin] = NULL;
+	BinMask = 0;
 
-	FreeList = (PMemDesc)MemStart;
-	NextItem = (PMemDesc)(0x00010000 + (long)MemStart);
-	FreeList->Prev = NULL;
-	FreeList->Next = NextItem;
-	FreeList->PageCount = 0;
-	NextItem->Prev = FreeList;
-	NextItem->Next = NULL;
-	NextItem->PageCount = (0x00098000 - PhysAddr(MemStart) >> 4) - 1;
+	HeapStart = (PMemDesc)MemStart;
+	HeapStart->PageCount = (unsigned short)((0x00098000 - PhysAddr(MemStart) >> 4) - 1);
+	HeapStart->Flags = 0;
+	HeapStart->MagicNum = MEM_MAGIC;
+	HeapEnd = MEM_MOVE(HeapStart,HeapStart->PageCount);
+	HeapEnd->PageCount = 1;
+	HeapEnd->Flags = 0;
+	HeapEnd->MagicNum = MEM_MAGIC;
+	BinInsert(HeapStart);
 }
 
 void *operator new (unsigned int Size)
 {
-	long PageCount;
-	PMemDesc MemDesc, OldDesc;
+#ifdef ALLOC_PROFILE
+	return ProfiledAlloc(Size,RETURN_ADDRESS());
+#else
+	return Allocate(Size);
+#endif
+}
+
+void operator delete (void *ptr)
+{
+	if (!ptr) {
+		printf("free(): NULL pointer\n");
+		wait();
+		return;
+	}
+#ifdef ALLOC_PROFILE
+	TAllocTag *Tag;
+	TAllocSite *Site;
+
+	if (IsAllocated(ptr) && (Tag = GetTag(ptr))->Site < PROFILE_SITES) {
+		Site = &Sites[Tag->Site];
+		--Site->Count;
+		Site->Bytes -= Tag->Size;
+	}
+#endif
+	if (FP_OFS(ptr))
+		PoolFree(ptr);
+	else
+		BlockFree(ptr);
+}
+
+static void *Allocate(unsigned int Size)
+{
+	if (Size <= POOL_MAXSIZE)
+		return PoolAlloc(SizeClass[Size + 15 >> 4]);
+	return BlockAlloc(Size);
+}
+
+static void *BlockAlloc(unsigned int Size)
+{
+	unsigned short PageCount;
+	PMemDesc MemDesc, Rest;
 
 	PageCount = 1 + (Size >> 4);
 	if (Size & 0x0f)
 		++PageCount;
 
-	for (MemDesc = FreeList->Next; MemDesc && MemDesc->PageCount < PageCount; MemDesc = MemDesc->Next);
-	if (!MemDesc) {
+	if ((MemDesc = FindFree(PageCount)) == NULL) {
 		printf("malloc(): out of memory\n");
 		return NULL;
 	}
-
-	OldDesc = MemDesc;
-	if (MemDesc->PageCount == PageCount) {
-		// remove entire free memory block
-		MemDesc->Prev->Next = MemDesc->Next;
-		if (MemDesc->Next)
-			MemDesc->Next->Prev = MemDesc->Prev;
+	BinRemove(MemDesc);
+	if (MemDesc->PageCount - PageCount >= MEM_MINPAGES) {
+		// the rest stays free
+		Rest = MEM_MOVE(MemDesc,PageCount);
+		Rest->PageCount = MemDesc->PageCount - PageCount;
+		Rest->Flags = 0;
+		Rest->MagicNum = MEM_MAGIC;
+		MemDesc->PageCount = PageCount;
+		BinInsert(Rest);
 	}
-	else {
-		// shrink free memory block
-		MemDesc = (PMemDesc)((PageCount << 16) + (long)MemDesc);
-		MemDesc->Next = OldDesc->Next;
-		MemDesc->Prev = OldDesc->Prev;
-		OldDesc->Prev->Next = MemDesc;
-		OldDesc->Next->Prev = MemDesc;
-		MemDesc->PageCount = OldDesc->PageCount - PageCount;
-		OldDesc->PageCount = PageCount;
-	}
-	OldDesc->MagicNum = 0xabcd0123;
-	return (void *)(0x00010000 + (unsigned long)OldDesc);
+	return (void *)MEM_MOVE(MemDesc,1);
 }
 
-void operator delete (void *ptr)
+static void BlockFree(void *ptr)
 {
-	PMemDesc Prev, Next, New;
-	unsigned long MergeNext;
+	PMemDesc MemDesc, Next, Prev;
 
-	if (!ptr) {
-		printf("free(): NULL pointer\n");
+	MemDesc = MEM_MOVE(ptr,-1);
+	if (MemDesc->MagicNum != MEM_MAGIC || MemDesc->Flags & MEM_FREE) {
+		printf("free(): invalid pointer\n");
 		wait();
 		return;
 	}
-	for (Next = FreeList->Next; (unsigned long)Next < (unsigned long)ptr; Next = Next->Next);
 
-	Prev = Next->Prev;
-	New = (PMemDesc)( ((unsigned long)ptr) - 0x00010000 );
+	Next = MEM_MOVE(MemDesc,MemDesc->PageCount);
+	if (Next->Flags & MEM_FREE) {
+		BinRemove(Next);
+		MemDesc->PageCount += Next->PageCount;
+		Next->MagicNum = 0;
+	}
+	if (MemDesc->Flags & MEM_PREVFREE) {
+		Prev = MEM_MOVE(MemDesc,-(long)*(unsigned short *)MEM_MOVE(MemDesc,-1));
+		BinRemove(Prev);
+		Prev->PageCount += MemDesc->PageCount;
+		MemDesc->MagicNum = 0;
+		MemDesc = Prev;
+	}
+	BinInsert(MemDesc);
+}
+
+static PMemDesc FindFree(unsigned short PageCount)
+/*
+ * Best fit in the bin of PageCount, which may hold smaller blocks as
+ * well. Any block of a larger bin fits.
+ */
+{
+	PMemDesc MemDesc, Best;
+	int Bin;
+
+	Bin = GetBin(PageCount);
+	Best = NULL;
+	for (MemDesc = Bins[Bin]; MemDesc; MemDesc = MemDesc->Next)
+		if (MemDesc->PageCount >= PageCount && (!Best || MemDesc->PageCount < Best->PageCount)) {
+			Best = MemDesc;
+			if (MemDesc->PageCount == PageCount)
+				break;
+		}
+	if (Best)
+		return Best;
+	for (++Bin; Bin < MEM_BINS; ++Bin)
+		if (BinMask & 1U << Bin)
+			return Bins[Bin];
+	return NULL;
+}
+
+static int GetBin(unsigned short PageCount)
+{
+	int Bin;
+
+	for (Bin = 0; PageCount >>= 1; ++Bin);
+	return Bin;
+}
+
+static void BinInsert(PMemDesc MemDesc)
+/*
+ * Also writes the footer and tells the next block
+ */
+{
+	int Bin;
+
+	Bin = GetBin(MemDesc->PageCount);
+	MemDesc->Prev = NULL;
+	MemDesc->Next = Bins[Bin];
+	if (MemDesc->Next)
+		MemDesc->Next->Prev = MemDesc;
+	Bins[Bin] = MemDesc;
+	BinMask |= 1U << Bin;
 
-	if (New->MagicNum != 0xabcd0123) {
+	MemDesc->Flags |= MEM_FREE;
+	MEM_FOOTER(MemDesc) = MemDesc->PageCount;
+	MEM_MOVE(MemDesc,MemDesc->PageCount)->Flags |= MEM_PREVFREE;
+}
+
+static void BinRemove(PMemDesc MemDesc)
+{
+	int Bin;
+
+	Bin = GetBin(MemDesc->PageCount);
+	if (MemDesc->Prev)
+		MemDesc->Prev->Next = MemDesc->Next;
+	else
+		if ((Bins[Bin] = MemDesc->Next) == NULL)
+			BinMask &= ~(1U << Bin);
+	if (MemDesc->Next)
+		MemDesc->Next->Prev = MemDesc->Prev;
+
+	MemDesc->Flags &= ~MEM_FREE;
+	MEM_MOVE(MemDesc,MemDesc->PageCount)->Flags &= ~MEM_PREVFREE;
+}
+
+static void *PoolAlloc(int Class)
+{
+	PPoolPage Page;
+	unsigned short Slot;
+
+	if ((Page = PoolPages[Class]) == NULL && (Page = NewPoolPage(Class)) == NULL)
+		return NULL;
+	Slot = Page->FreeSlot;
+	Page->FreeSlot = *(unsigned short *)MK_FP(FP_SEG(Page),Slot);
+	++Page->Used;
+	if (!Page->FreeSlot)
+		UnlinkPoolPage(Page);
+	PoolBytesUsed += ClassSize[Class];
+	return MK_FP(FP_SEG(Page),Slot);
+}
+
+static void PoolFree(void *ptr)
+/*
+ * A page that becomes empty goes back to the first fit allocator,
+ * unless it's the only page of its class with free slots.
+ */
+{
+	PPoolPage Page;
+
+	Page = (PPoolPage)MK_FP(FP_SEG(ptr),0);
+	if (Page->MagicNum != POOL_MAGIC || !Page->Used) {
 		printf("free(): invalid pointer\n");
 		wait();
 		return;
 	}
+	if (!Page->FreeSlot)
+		LinkPoolPage(Page);
+	*(unsigned short *)ptr = Page->FreeSlot;
+	Page->FreeSlot = FP_OFS(ptr);
+	PoolBytesUsed -= ClassSize[Page->Class];
+	if (--Page->Used || (!Page->Prev && !Page->Next))
+		return;
+	UnlinkPoolPage(Page);
+	Page->MagicNum = 0;
+	--PoolPageCount;
+	BlockFree(Page);
+}
 
-	MergeNext = (Prev->PageCount << 16) + (long)Prev;
-	if (MergeNext == (unsigned long)New) {
-		Prev->PageCount += New->PageCount;
-		New = Prev;
-	}
-	else {
-		Prev->Next = New;
-		New->Prev = Prev;
-	}
-	MergeNext = (New->PageCount << 16) + (long)New;
-	if (MergeNext == (unsigned long)Next) {
-		New->PageCount += Next->PageCount;
-		New->Next = Next->Next;
-		if (Next->Next)
-			Next->Next->Prev = New;
-	}
-	else {
-		New->Next = Next;
-		Next->Prev = New;
+static PPoolPage NewPoolPage(int Class)
+{
+	PPoolPage Page;
+	int Size, Index;
+	unsigned short Slot;
+
+	if ((Page = (PPoolPage)BlockAlloc(POOL_PAGESIZE)) == NULL)
+		return NULL;
+	Page->Used = 0;
+	Page->Class = Class;
+	Page->MagicNum = POOL_MAGIC;
+
+	// free list in address order
+	Size = ClassSize[Class];
+	Page->FreeSlot = 0;
+	for (Index = (POOL_PAGESIZE - sizeof (TPoolPage)) / Size; Index--; ) {
+		Slot = sizeof (TPoolPage) + Index * Size;
+		*(unsigned short *)MK_FP(FP_SEG(Page),Slot) = Page->FreeSlot;
+		Page->FreeSlot = Slot;
 	}
+	LinkPoolPage(Page);
+	++PoolPageCount;
+	return Page;
+}
+
+static void LinkPoolPage(PPoolPage Page)
+{
+	Page->Prev = NULL;
+	Page->Next = PoolPages[Page->Class];
+	if (Page->Next)
+		Page->Next->Prev = Page;
+	PoolPages[Page->Class] = Page;
+}
+
+static void UnlinkPoolPage(PPoolPage Page)
+{
+	if (Page->Prev)
+		Page->Prev->Next = Page->Next;
+	else
+		PoolPages[Page->Class] = Page->Next;
+	if (Page->Next)
+		Page->Next->Prev = Page->Prev;
+	Page->Next = Page->Prev = NULL;
 }
 
 long CoreLeft()
 {
 	PMemDesc Entry;
 	long Core = 0;
+	int Bin;
 
-	for (Entry = FreeList->Next; Entry; Entry = Entry->Next)
-		Core += Entry->PageCount;
+	for (Bin = 0; Bin < MEM_BINS; ++Bin)
+		for (Entry = Bins[Bin]; Entry; Entry = Entry->Next)
+			Core += Entry->PageCount;
 	return Core << 4;
-}
\ No newline at end of file
+}
+
+void GetHeapStats(THeapStats &Stats)
+{
+	PMemDesc Entry;
+	int Bin;
+
+	Stats.FreeBytes = 0;
+	Stats.LargestFree = 0;
+	Stats.FreeBlocks = 0;
+	for (Bin = 0; Bin < MEM_BINS; ++Bin)
+		for (Entry = Bins[Bin]; Entry; Entry = Entry->Next) {
+			Stats.FreeBytes += (long)Entry->PageCount << 4;
+			if ((long)Entry->PageCount << 4 > Stats.LargestFree)
+				Stats.LargestFree = (long)Entry->PageCount << 4;
+			++Stats.FreeBlocks;
+		}
+	Stats.PoolPages = PoolPageCount;
+	Stats.PoolUsed = PoolBytesUsed;
+	Stats.PoolFree = (long)PoolPageCount * (POOL_PAGESIZE - sizeof (TPoolPage)) - PoolBytesUsed;
+}
+
+#ifdef DOS_DEBUG
+int VerifyHeap()
+/*
+ * Walks every block from the start of the heap to the end, then every
+ * bin. Returns -1, after printing the segment of the block, when
+ * something is wrong.
+ */
+{
+	PMemDesc MemDesc;
+	int PrevFree, Bin;
+	int FreeBlocks;
+
+	PrevFree = false;
+	FreeBlocks = 0;
+	for (MemDesc = HeapStart; (unsigned long)MemDesc < (unsigned long)HeapEnd; MemDesc = MEM_MOVE(MemDesc,MemDesc->PageCount)) {
+		if (MemDesc->MagicNum != MEM_MAGIC || !MemDesc->PageCount) {
+			printf("heap: bad block at %x\n",FP_SEG(MemDesc));
+			return -1;
+		}
+		if (!(MemDesc->Flags & MEM_PREVFREE) != !PrevFree) {
+			printf("heap: bad MEM_PREVFREE at %x\n",FP_SEG(MemDesc));
+			return -1;
+		}
+		PrevFree = MemDesc->Flags & MEM_FREE;
+		if (PrevFree) {
+			if (MemDesc->Flags & MEM_PREVFREE || MEM_FOOTER(MemDesc) != MemDesc->PageCount) {
+				printf("heap: bad free block at %x\n",FP_SEG(MemDesc));
+				return -1;
+			}
+			++FreeBlocks;
+		}
+	}
+	if (MemDesc != HeapEnd || HeapEnd->MagicNum != MEM_MAGIC || !(HeapEnd->Flags & MEM_PREVFREE) != !PrevFree) {
+		printf("heap: bad end at %x\n",FP_SEG(MemDesc));
+		return -1;
+	}
+
+	for (Bin = 0; Bin < MEM_BINS; ++Bin)
+		for (MemDesc = Bins[Bin]; MemDesc; MemDesc = MemDesc->Next) {
+			if (MemDesc->MagicNum != MEM_MAGIC || !(MemDesc->Flags & MEM_FREE) ||
+				 GetBin(MemDesc->PageCount) != Bin) {
+				printf("heap: bad block in bin %d at %x\n",Bin,FP_SEG(MemDesc));
+				return -1;
+			}
+			--FreeBlocks;
+		}
+	if (FreeBlocks) {
+		printf("heap: %d free blocks not in a bin\n",FreeBlocks);
+		return -1;
+	}
+	return 0;
+}
+#endif
+
+#ifdef ALLOC_PROFILE
+void *ProfiledAlloc(unsigned int Size, unsigned long Address)
+{
+	void *ptr;
+	TAllocTag *Tag;
+	TAllocSite *Site;
+
+	if ((ptr = Allocate(Size + sizeof (TAllocTag))) == NULL) {
+		printf("malloc(): %u bytes from %x:%x\n",Size,(unsigned short)(Address >> 16),(unsigned short)Address);
+		return NULL;
+	}
+	Tag = GetTag(ptr);
+	Tag->Site = FindSite(Address);
+	Tag->Size = Size;
+	Site = &Sites[Tag->Site];
+	++Site->Count;
+	++Site->Allocs;
+	if ((Site->Bytes += Size) > Site->Peak)
+		Site->Peak = Site->Bytes;
+	return ptr;
+}
+
+static unsigned short FindSite(unsigned long Address)
+/*
+ * Open addressing, a new address takes the first unused entry
+ */
+{
+	unsigned short Index;
+	int Probe;
+
+	Index = (unsigned short)(Address ^ Address >> 16) & (PROFILE_SITES - 1);
+	for (Probe = 0; Probe < PROFILE_SITES; ++Probe, Index = Index + 1 & (PROFILE_SITES - 1)) {
+		if (!Index)
+			continue;
+		if (Sites[Index].Address == Address)
+			return Index;
+		if (!Sites[Index].Address) {
+			Sites[Index].Address = Address;
+			return Index;
+		}
+	}
+	return 0;
+}
+
+static TAllocTag *GetTag(void *ptr)
+/*
+ * The tag is in the last bytes of the slot or the block
+ */
+{
+	PMemDesc MemDesc;
+
+	if (FP_OFS(ptr))
+		return (TAllocTag *)MK_FP(FP_SEG(ptr),FP_OFS(ptr) + ClassSize[((PPoolPage)MK_FP(FP_SEG(ptr),0))->Class] - sizeof (TAllocTag));
+	MemDesc = MEM_MOVE(ptr,-1);
+	return (TAllocTag *)MK_FP(FP_SEG(MemDesc) + MemDesc->PageCount - 1,16 - sizeof (TAllocTag));
+}
+
+static int IsAllocated(void *ptr)
+/*
+ * The tag of a pointer delete will reject can't be trusted
+ */
+{
+	PPoolPage Page;
+	PMemDesc MemDesc;
+
+	if (FP_OFS(ptr)) {
+		Page = (PPoolPage)MK_FP(FP_SEG(ptr),0);
+		return Page->MagicNum == POOL_MAGIC && Page->Used;
+	}
+	MemDesc = MEM_MOVE(ptr,-1);
+	return MemDesc->MagicNum == MEM_MAGIC && !(MemDesc->Flags & MEM_FREE);
+}
+
+void DumpHeap(const char *FileName)
+/*
+ * Call sites are far addresses in memory. The address of AllocInit
+ * is written first, to relate them to the map file.
+ */
+{
+	int Handle;
+	int Index;
+	PMemDesc MemDesc;
+	PPoolPage Page;
+	TAllocTag *Tag;
+
+	Handle = DosCreate(FileName);
+	DumpText(Handle,"AllocInit at ");
+	DumpAddress(Handle,(unsigned long)(void far *)AllocInit);
+
+	DumpText(Handle,"\r\n\r\nsite         live   bytes    peak  allocs\r\n");
+	for (Index = 0; Index < PROFILE_SITES; ++Index)
+		if (Sites[Index].Allocs) {
+			DumpAddress(Handle,Sites[Index].Address);
+			DumpNumber(Handle,Sites[Index].Count,DEC,8);
+			DumpNumber(Handle,Sites[Index].Bytes,DEC,8);
+			DumpNumber(Handle,Sites[Index].Peak,DEC,8);
+			DumpNumber(Handle,Sites[Index].Allocs,DEC,8);
+			DumpText(Handle,"\r\n");
+		}
+
+	DumpText(Handle,"\r\nseg    bytes\r\n");
+	for (MemDesc = HeapStart; (unsigned long)MemDesc < (unsigned long)HeapEnd; MemDesc = MEM_MOVE(MemDesc,MemDesc->PageCount)) {
+		DumpNumber(Handle,FP_SEG(MemDesc),HEX,4);
+		DumpNumber(Handle,(long)MemDesc->PageCount << 4,DEC,8);
+		if (MemDesc->Flags & MEM_FREE)
+			DumpText(Handle,"  free");
+		else {
+			Page = (PPoolPage)MEM_MOVE(MemDesc,1);
+			if (Page->MagicNum == POOL_MAGIC) {
+				DumpText(Handle,"  pool of");
+				DumpNumber(Handle,ClassSize[Page->Class],DEC,4);
+				DumpText(Handle,", used");
+				DumpNumber(Handle,Page->Used,DEC,4);
+			}
+			else {
+				Tag = GetTag(Page);
+				DumpText(Handle,"  from ");
+				if (Tag->Site < PROFILE_SITES)
+					DumpAddress(Handle,Sites[Tag->Site].Address);
+			}
+		}
+		DumpText(Handle,"\r\n");
+	}
+	DosClose(Handle);
+}
+
+static void DumpText(int Handle, const char *Str)
+{
+	DosWrite(Handle,Str,strlen(Str));
+}
+
+static void DumpNumber(int Handle, long Value, int Base, int Width)
+/*
+ * Right aligned, hex is padded with zeros
+ */
+{
+	char Str[12];
+	int Length;
+
+	itoa(Value,Str,Base);
+	for (Length = strlen(Str); Length < Width; ++Length)
+		DumpText(Handle,Base == HEX ? "0" : " ");
+	DumpText(Handle,Str);
+}
+
+static void DumpAddress(int Handle, unsigned long Address)
+{
+	DumpNumber(Handle,Address >> 16,HEX,4);
+	DumpText(Handle,":");
+	DumpNumber(Handle,Address & 0xffff,HEX,4);
+}
+#endif
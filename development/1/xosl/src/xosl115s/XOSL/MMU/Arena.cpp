@@ -0,0 +1,77 @@
+/*
+ * Extended Operating System Loader (XOSL)
+ * Copyright (c) 1999 by Geurt Vos
+ *
+ * This code is distributed under GNU General Public License (GPL)
+ *
+ * The full text of the license can be found in the GPL.TXT file,
+ * or at http://www.gnu.org
+ */
+
+/*
+ * Chunks are blocks of the allocation unit, which start at offset 0 of
+ * their segment. The objects in a chunk never do, so the chunk header
+ * of an object is found at offset 0 of its segment.
+ */
+
+#include <arena.h>
+#include <mem.h>
+
+extern void printf(const char *fmt, ...);
+
+CArena::CArena(unsigned short ChunkSize)
+{
+	Chunks = NULL;
+	this->ChunkSize = ChunkSize;
+}
+
+CArena::~CArena()
+{
+	Release();
+}
+
+void *CArena::Alloc(unsigned short Size)
+{
+	TArenaChunk *Chunk;
+	unsigned short NewSize;
+	void *Object;
+
+	Size = Size + 1 & ~1;
+	if (!Chunks || Chunks->Size - Chunks->Used < Size) {
+		NewSize = sizeof (TArenaChunk) + Size;
+		if (NewSize < ChunkSize)
+			NewSize = ChunkSize;
+		if ((Chunk = (TArenaChunk *)new char[NewSize]) == NULL)
+			return NULL;
+		if (FP_OFS(Chunk)) {
+			// too small for a block of its own
+			printf("CArena: chunk size\n");
+			delete Chunk;
+			return NULL;
+		}
+		Chunk->Next = Chunks;
+		Chunk->Used = sizeof (TArenaChunk);
+		Chunk->Size = NewSize;
+		Chunk->MagicNum = ARENA_MAGIC;
+		Chunks = Chunk;
+	}
+	Object = MK_FP(FP_SEG(Chunks),Chunks->Used);
+	Chunks->Used += Size;
+	return Object;
+}
+
+void CArena::Release()
+{
+	TArenaChunk *Chunk;
+
+	for (; Chunks; Chunks = Chunk) {
+		Chunk = Chunks->Next;
+		Chunks->MagicNum = 0;
+		delete Chunks;
+	}
+}
+
+int CArena::Contains(const void *ptr)
+{
+	return FP_OFS(ptr) && ((TArenaChunk *)MK_FP(FP_SEG(ptr),0))->MagicNum == ARENA_MAGIC;
+}
@@ -13,6 +13,7 @@
 #include <com.h>
 #include <int.h>
 #include <mem.h>
+#include <event.h>
 
 //#include <comm.h>
 
@@ -219,6 +220,7 @@ void far MouseHandler(short P0, char dY, char dX, short Status)
 	MouseY -= dY;
 	MouseClick = Status & 0x07;
 	AdjustXY();
+	CEventQueue::Post(EVENT_MOUSE,MouseClick);
 
 	SetHandlerDSeg();
 	Sti();
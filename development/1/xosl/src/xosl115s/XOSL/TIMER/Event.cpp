@@ -0,0 +1,126 @@
+/*
+ * Extended Operating System Loader (XOSL)
+ * Copyright (c) 1999 by Geurt Vos
+ *
+ * This code is distributed under GNU General Public License (GPL)
+ *
+ * The full text of the license can be found in the GPL.TXT file,
+ * or at http://www.gnu.org
+ */
+
+#include <event.h>
+#include <int.h>
+
+#define Cli() (__emit__(0xfa))
+#define Sti() (__emit__(0xfb))
+#define StiHlt() (__emit__(0xfb,0xf4)) // hlt executes before any interrupt
+#define PushfCli() (__emit__(0x9c,0xfa))
+#define Popf() (__emit__(0x9d))
+
+#define KEYBOARD_INT 0x09
+#define USERTICK_INT 0x1c
+
+#define KbdHead ( *(volatile unsigned short far *)0x0040001aL )
+#define KbdTail ( *(volatile unsigned short far *)0x0040001cL )
+
+static TEvent Queue[EVENTQUEUE_SIZE];
+static volatile unsigned short Head, Tail;
+static int Installed = 0;
+
+static void interrupt (*KeyboardOld)(void);
+static void interrupt (*UserTickOld)(void);
+
+static void interrupt KeyboardHandler(void)
+{
+	(*KeyboardOld)();
+	// break codes and shift keys don't end up in the buffer
+	if (KbdHead != KbdTail)
+		CEventQueue::Post(EVENT_KEY,KbdHead);
+}
+
+static void interrupt UserTickHandler(void)
+{
+	CEventQueue::Post(EVENT_TIMER,0);
+	(*UserTickOld)();
+}
+
+void CEventQueue::Install()
+{
+	if (Installed)
+		return;
+	Head = Tail = 0;
+	KeyboardOld = GetVect(KEYBOARD_INT);
+	UserTickOld = GetVect(USERTICK_INT);
+	SetVect(KEYBOARD_INT,KeyboardHandler);
+	SetVect(USERTICK_INT,UserTickHandler);
+	Installed = 1;
+}
+
+void CEventQueue::Remove()
+{
+	if (!Installed)
+		return;
+	SetVect(KEYBOARD_INT,KeyboardOld);
+	SetVect(USERTICK_INT,UserTickOld);
+	Installed = 0;
+}
+
+void CEventQueue::Post(int Type, int Data)
+/*
+ * Called from interrupt handlers, so it leaves the interrupt flag
+ * the way it found it.
+ */
+{
+	unsigned short NewTail;
+
+	PushfCli();
+	NewTail = (Tail + 1) & (EVENTQUEUE_SIZE - 1);
+	if (NewTail != Head) {
+		Queue[Tail].Type = Type;
+		Queue[Tail].Data = Data;
+		Tail = NewTail;
+	}
+	Popf();
+}
+
+void CEventQueue::WaitEvent(TEvent &Event)
+{
+	if (!Installed) {
+		Event.Type = EVENT_NONE;
+		return;
+	}
+	for (;;) {
+		Cli();
+		if (Head != Tail)
+			break;
+		StiHlt();
+	}
+	Event = Queue[Head];
+	Head = (Head + 1) & (EVENTQUEUE_SIZE - 1);
+	Sti();
+}
+
+void CEventQueue::Coalesce(const TEvent &Event)
+/*
+ * A mouse move that is followed by another one with the same button
+ * state carries no information, the position is read from CMouse.
+ */
+{
+	Cli();
+	while (Head != Tail && Queue[Head].Type == Event.Type && Queue[Head].Data == Event.Data)
+		Head = (Head + 1) & (EVENTQUEUE_SIZE - 1);
+	Sti();
+}
+
+void CEventQueue::Idle()
+{
+	if (!Installed)
+		return;
+	Cli();
+	if (Head == Tail)
+		StiHlt();
+	else {
+		Head = Tail;
+		Sti();
+	}
+}
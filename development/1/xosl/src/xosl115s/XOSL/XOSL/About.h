@@ -37,6 +37,7 @@ class CAbout {
 		CXOSLData &XoslData;
 
 		bool Initialized;
+		CArena Arena; // holds the controls
 
 		void Initialize();
 		void CreateControls();
@@ -2,6 +2,7 @@
 
 #include <ColorSettings.h>
 #include <timer.h>
+#include <event.h>
 
 static const char *ColorSchemes[16] = {
 	"Brick","Desert","Eggplant","Lilac","Maple","Marine","Plum",
@@ -27,30 +28,30 @@ CColorSettings::~CColorSettings()
 }
 
 
-void CColorSettings::CreateControls()
+void CColorSettings::CreateControls(CArena &Arena)
 {
-	SchemeGroup = new CBevel(BEVEL_FRAME,true,24,32,177,217,false);
-	ColorScheme = new CLabel(StrClColorScheme,STYLE_REGULAR,false,17,32,25,false);
-	SchemeListBox = new CListBox(1,false,48,56,129,169,false,this);
-	ScrollBar = new CScrollBar(0,0,0,false,158,57,167,false,SchemeListBox);
-	AdjustGroup = new CBevel(BEVEL_FRAME,true,216,32,233,137,false);
-	Adjustment = new CLabel(StrClAdjustment,STYLE_REGULAR,false,17,224,25,false);
-	HueLabel = new CLabel("Hue:",STYLE_REGULAR,true,17,232,57,false);
-	SatLabel = new CLabel("Saturation:",STYLE_REGULAR,true,17,232,89,false);
-	LumLabel = new CLabel("Luminance:",STYLE_REGULAR,true,17,232,121,false);
-	HueValue = new CLabel("0",STYLE_REGULAR,true,17,408,72,39,false);
-	SatValue = new CLabel("0%",STYLE_REGULAR,true,17,408,104,39,false);
-	LumValue = new CLabel("0%",STYLE_REGULAR,true,17,408,136,39,false);
-	HueSlider = new CTrackBar(-63,63,0,232,72,169,false,this);
-	SatSlider = new CTrackBar(-63,63,0,232,104,169,false,this);
-	LumSlider = new CTrackBar(-51,50,0,232,136,169,false,this);
-
-	FadeGroup = new CBevel(BEVEL_FRAME,true,216,184,233,97,false);
-	FadeColor = new CLabel(StrClFadeColor,STYLE_REGULAR,false,17,224,177,false);
-	FadeIntLabel = new CLabel("Intensity:",STYLE_REGULAR,true,17,232,205,false);
-	FadeIntSlider = new CTrackBar(0,100,100,232,220,169,false,this);
-	FadeIntValue = new CLabel("100%",STYLE_REGULAR,true,17,408,220,39,false);
-	FadeTestBtn = new CButton("Test",295,244,75,25,false,this);
+	SchemeGroup = new (Arena) CBevel(BEVEL_FRAME,true,24,32,177,217,false);
+	ColorScheme = new (Arena) CLabel(StrClColorScheme,STYLE_REGULAR,false,17,32,25,false);
+	SchemeListBox = new (Arena) CListBox(1,false,48,56,129,169,false,this);
+	ScrollBar = new (Arena) CScrollBar(0,0,0,false,158,57,167,false,SchemeListBox);
+	AdjustGroup = new (Arena) CBevel(BEVEL_FRAME,true,216,32,233,137,false);
+	Adjustment = new (Arena) CLabel(StrClAdjustment,STYLE_REGULAR,false,17,224,25,false);
+	HueLabel = new (Arena) CLabel("Hue:",STYLE_REGULAR,true,17,232,57,false);
+	SatLabel = new (Arena) CLabel("Saturation:",STYLE_REGULAR,true,17,232,89,false);
+	LumLabel = new (Arena) CLabel("Luminance:",STYLE_REGULAR,true,17,232,121,false);
+	HueValue = new (Arena) CLabel("0",STYLE_REGULAR,true,17,408,72,39,false);
+	SatValue = new (Arena) CLabel("0%",STYLE_REGULAR,true,17,408,104,39,false);
+	LumValue = new (Arena) CLabel("0%",STYLE_REGULAR,true,17,408,136,39,false);
+	HueSlider = new (Arena) CTrackBar(-63,63,0,232,72,169,false,this);
+	SatSlider = new (Arena) CTrackBar(-63,63,0,232,104,169,false,this);
+	LumSlider = new (Arena) CTrackBar(-51,50,0,232,136,169,false,this);
+
+	FadeGroup = new (Arena) CBevel(BEVEL_FRAME,true,216,184,233,97,false);
+	FadeColor = new (Arena) CLabel(StrClFadeColor,STYLE_REGULAR,false,17,224,177,false);
+	FadeIntLabel = new (Arena) CLabel("Intensity:",STYLE_REGULAR,true,17,232,205,false);
+	FadeIntSlider = new (Arena) CTrackBar(0,100,100,232,220,169,false,this);
+	FadeIntValue = new (Arena) CLabel("100%",STYLE_REGULAR,true,17,408,220,39,false);
+	FadeTestBtn = new (Arena) CButton("Test",295,244,75,25,false,this);
 
 }
 
@@ -234,7 +235,7 @@ void CColorSettings::FadeTestClick(CColorSettings &ColorSettings)
 	Graph->Palette->LockFading();
 	Graph->Palette->SetFadeOutColor(ColorSettings.XoslData.GetColor()->FadeColorInt);
 	Graph->Palette->FadeOut();
-	for (TimerTicks = GetTimerTicks() + 18; TimerTicks != GetTimerTicks(); );
+	for (TimerTicks = GetTimerTicks() + 18; TimerTicks != GetTimerTicks(); CEventQueue::Idle());
 	Graph->Palette->FadeIn();
 }
 
@@ -11,7 +11,7 @@ public:
 	CColorSettings(CXOSLData &XoslDataToUse);
 	~CColorSettings();
 
-	void CreateControls();
+	void CreateControls(CArena &Arena);
 	void InitializeControls(CTabControl *TabControl);
 	void ConnectEventHandlers();
 	void InitializeData();
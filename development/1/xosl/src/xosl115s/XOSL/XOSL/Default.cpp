@@ -2,6 +2,7 @@
 #include <Default.h>
 #include <String.h>
 #include <Timer.h>
+#include <Event.h>
 
 #include <Graph.h>
 
@@ -97,6 +98,7 @@ int CDefaultBoot::WaitTimeout()
 		BootLabel->SetCaption(BootString);
 		Progress = (TimePassed * 3600) >> 12;
 		ProgressBar->SetProgress(Progress);
+		Graph->Flush();
 
 		if (CKeyboard::KeyStrokeAvail()) {
 			Key = CKeyboard::WaitKeyStroke();
@@ -117,7 +119,7 @@ int CDefaultBoot::WaitTimeout()
 			Loader.SelectDefault();
 			return -1;
 		}
-	
+		CEventQueue::Idle();
 	}
 }
 /*
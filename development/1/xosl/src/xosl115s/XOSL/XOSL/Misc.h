@@ -15,7 +15,7 @@ public:
 	CMiscellaneous(CXOSLData &XoslDataToUse, CPreference &PreferenceToUse);
 	~CMiscellaneous();
 
-	void CreateControls();
+	void CreateControls(CArena &Arena);
 	void InitializeControls(CTabControl *TabControl);
 	void ConnectEventHandlers();
 	void InitializeData();
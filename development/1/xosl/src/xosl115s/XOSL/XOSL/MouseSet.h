@@ -12,7 +12,7 @@ public:
 	CMouseSettings(CXOSLData &XoslDataToUse, CDialogs &DialogsToUse, CMouse &MouseToUse);
 	~CMouseSettings();
 
-	void CreateControls();
+	void CreateControls(CArena &Arena);
 	void InitializeControls(CTabControl *TabControl);
 	void ConnectEventHandlers();
 	void InitializeData();
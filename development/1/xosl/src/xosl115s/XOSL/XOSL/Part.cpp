@@ -36,7 +36,6 @@ void CPartDialog::ShowModal(CForm *Owner, const char *Caption, const char *Defau
 		InitializeControls();
 		InstallControls();
 
-		PartList.ReadVolumeLabels();
 		InitializeDialog();
 		Initialized = true;
 	}
@@ -90,6 +89,7 @@ void CPartDialog::InitializeControls()
 	ApplyBtn->OnClick((TWndOnClick)ApplyBtnClick);
     CancelBtn->OnClick((TWndOnClick)CancelBtnClick);
 	PartListBox->OnSelect((TListBoxSelect)PartListBoxSelect);
+	PartListBox->OnScroll((TListBoxSelect)PartListBoxScroll);
 	NameEdit->OnKeyPress((TWndOnKeyPress)NameEditKeyPress);
 	PartListBox->OnKeyPress((TWndOnKeyPress)PartListBoxKeyPress);
 //	ScrollBar->OnKeyPress((TWndOnKeyPress)PartListBoxKeyPress);
@@ -133,9 +133,26 @@ void CPartDialog::InitializeDialog()
 		AddVolume(Row,Partition->VolumeLabel);
 
 	}
+	UpdateVolumes(0);
 	PartListBox->SetItemIndex(1);
 }
 
+void CPartDialog::UpdateVolumes(int DrawStart)
+/*
+ * Labels are only read for the rows that are actually shown
+ */
+{
+	int Row, DrawEnd;
+
+	// including the partially visible row at the bottom
+	DrawEnd = DrawStart + PartListBox->GetDrawCount() + 1;
+	PartList.ReadVolumeLabels(DrawStart,DrawEnd - DrawStart);
+	if (DrawEnd > PartList.GetCount())
+		DrawEnd = PartList.GetCount();
+	for (Row = DrawStart; Row < DrawEnd; ++Row)
+		AddVolume(Row,PartList.GetPartition(Row)->VolumeLabel);
+}
+
 void CPartDialog::AddDisk(int Row, int Drive)
 {
 	CString Msg;
@@ -222,10 +239,16 @@ void CPartDialog::CancelBtnClick(CPartDialog &PartDialog)
 void CPartDialog::PartListBoxSelect(CPartDialog &PartDialog, int ItemIndex)
 {
 	if (PartDialog.AutoName) {
+		PartDialog.PartList.ReadVolumeLabels(ItemIndex,1);
 		PartDialog.NameEdit->SetText(PartDialog.PartList.GetPartition(ItemIndex)->VolumeLabel);
 	}
 }
 
+void CPartDialog::PartListBoxScroll(CPartDialog &PartDialog, int DrawStart)
+{
+	PartDialog.UpdateVolumes(DrawStart);
+}
+
 void CPartDialog::NameEditKeyPress(CPartDialog &PartDialog, unsigned short &Key)
 {
 	PartDialog.AutoName = false;
@@ -16,16 +16,16 @@ CPassword::~CPassword()
 {
 }
 
-void CPassword::CreateControls()
+void CPassword::CreateControls(CArena &Arena)
 {
-	PasswordGroupBevel = new CBevel(BEVEL_FRAME,true,28,237,337,122,false);
-	PasswordGroupLabel = new CLabel(StrPassword,STYLE_REGULAR,false,17,36,230,false);
-	NewPassLabel = new CLabel("New password",STYLE_REGULAR,true,17,52,254,false);
-	NewPassEdit = new CEdit("",32,true,false,52,270,129,false,this);
-	ConfirmPassLabel = new CLabel("Confirm password",STYLE_REGULAR,true,17,212,254,false);
-	ConfirmPassEdit = new CEdit("",32,true,false,212,270,129,false,this);
-	ApplyPassBtn = new CButton("Apply",264,298,75,25,false,this);
-	ClearPassBtn = new CButton("Clear",53,298,75,25,false,this);
+	PasswordGroupBevel = new (Arena) CBevel(BEVEL_FRAME,true,28,237,337,122,false);
+	PasswordGroupLabel = new (Arena) CLabel(StrPassword,STYLE_REGULAR,false,17,36,230,false);
+	NewPassLabel = new (Arena) CLabel("New password",STYLE_REGULAR,true,17,52,254,false);
+	NewPassEdit = new (Arena) CEdit("",32,true,false,52,270,129,false,this);
+	ConfirmPassLabel = new (Arena) CLabel("Confirm password",STYLE_REGULAR,true,17,212,254,false);
+	ConfirmPassEdit = new (Arena) CEdit("",32,true,false,212,270,129,false,this);
+	ApplyPassBtn = new (Arena) CButton("Apply",264,298,75,25,false,this);
+	ClearPassBtn = new (Arena) CButton("Clear",53,298,75,25,false,this);
 }
 
 void CPassword::InitializeControls(CTabControl *TabControl)
@@ -12,7 +12,7 @@ public:
 	CPassword(CSetup &SetupToUse, CBootItems &BootItemsToUse, CDialogs &DialogsToUse);
 	~CPassword();
 
-	void CreateControls();
+	void CreateControls(CArena &Arena);
 	void InitializeControls(CTabControl *TabControl);
 	void ConnectEventHandlers();
 	void DisableControls();
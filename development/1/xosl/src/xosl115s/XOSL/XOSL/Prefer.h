@@ -66,6 +66,7 @@ private:
 
 	bool Initialized;
 	bool IgnoreKey;
+	CArena Arena; // holds the controls, those of the pages as well
 
 	void Initialize();
 	void CreateControls();
@@ -19,17 +19,17 @@ CXoslPassword::~CXoslPassword()
 
 }
 
-void CXoslPassword::CreateControls()
+void CXoslPassword::CreateControls(CArena &Arena)
 {
-	Group = new CBevel(BEVEL_FRAME,true,132,32,201,217,false);
-	Label = new CLabel(StrPwLabel,STYLE_REGULAR,false,17,140,25,false);
-	OldLabel = new CLabel("Old password:",STYLE_REGULAR,true,17,172,56,false);
-	NewLabel = new CLabel("New password:",STYLE_REGULAR,true,17,172,104,false);
-	ReLabel = new CLabel("Re-enter password:",STYLE_REGULAR,true,17,172,152,false);
-	OldEdit = new CEdit("",32,true,false,172,72,121,false,this);
-	NewEdit = new CEdit("",32,true,false,172,120,121,false,this);
-	ReEdit = new CEdit("",32,true,false,172,168,121,false,this);
-	ApplyBtn = new CButton("Apply",195,208,75,25,false,this);
+	Group = new (Arena) CBevel(BEVEL_FRAME,true,132,32,201,217,false);
+	Label = new (Arena) CLabel(StrPwLabel,STYLE_REGULAR,false,17,140,25,false);
+	OldLabel = new (Arena) CLabel("Old password:",STYLE_REGULAR,true,17,172,56,false);
+	NewLabel = new (Arena) CLabel("New password:",STYLE_REGULAR,true,17,172,104,false);
+	ReLabel = new (Arena) CLabel("Re-enter password:",STYLE_REGULAR,true,17,172,152,false);
+	OldEdit = new (Arena) CEdit("",32,true,false,172,72,121,false,this);
+	NewEdit = new (Arena) CEdit("",32,true,false,172,120,121,false,this);
+	ReEdit = new (Arena) CEdit("",32,true,false,172,168,121,false,this);
+	ApplyBtn = new (Arena) CButton("Apply",195,208,75,25,false,this);
 }
 
 void CXoslPassword::InitializeControls(CTabControl *TabControl)
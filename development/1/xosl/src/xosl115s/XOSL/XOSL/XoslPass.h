@@ -12,7 +12,7 @@ public:
 	CXoslPassword(CXOSLData &XoslDataToUse, CDialogs &DialogsToUse);
 	~CXoslPassword();
 
-	void CreateControls();
+	void CreateControls(CArena &Arena);
 	void InitializeControls(CTabControl *TabControl);
 	void ConnectEventHandlers();
 
@@ -65,6 +65,7 @@ class CApplication {
 		void LoadSplashLogo();
 		void LoadAdditionalFont();
 		void LoadWallpaper();
+		static unsigned char *CompactBitmap(unsigned char *Bitmap);
 
 		void InitializeMouse();
 		void InitAppGraphics();
@@ -26,7 +26,8 @@ typedef struct {
 	int DisplayItemIndex;
 	int ClearScreen;
 	int NoAnimation;
-	int Reserved[5];
+	int StretchWallpaper;
+	int Reserved[4];
 } TGraphData;
 
 typedef struct {